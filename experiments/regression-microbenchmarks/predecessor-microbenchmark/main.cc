@@ -0,0 +1,171 @@
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "old_regression_state_registry.h"
+
+#include "regression/fact_mutex_table.h"
+#include "regression/partial_state_task.h"
+#include "regression/regression_state_registry.h"
+#include "regression/regression_successor_generator.h"
+#include "regression/regression_task.h"
+#include "tasks/root_task.h"
+
+using namespace std;
+
+
+struct PredecessorCall {
+    StateID successor;
+    OperatorID op;
+    StateID predecessor;
+};
+
+
+void benchmark(const string &desc, int num_calls,
+               const function<void()> &func) {
+    cout << "Running " << desc << " " << num_calls << " times:" << flush;
+    clock_t start = clock();
+    for (int i = 0; i < num_calls; ++i)
+        func();
+    clock_t end = clock();
+    double duration = static_cast<double>(end - start) / CLOCKS_PER_SEC;
+    cout << " " << duration << " seconds" << endl;
+}
+
+
+/*
+  Regress breadth-first from the goal until the registry holds
+  max_states states and return the calls of get_predecessor_state.
+*/
+template<class Registry>
+vector<PredecessorCall> regress(
+    Registry &registry, const State &goal,
+    const regression_successor_generator::RegressionSuccessorGenerator &generator,
+    const OperatorsProxy &operators, size_t max_states) {
+    vector<PredecessorCall> calls;
+    deque<StateID> queue;
+    queue.push_back(registry.create_goal_state(goal).get_id());
+    vector<OperatorID> ops;
+
+    while (!queue.empty() && registry.size() < max_states) {
+        GlobalState successor = registry.lookup_state(queue.front());
+        queue.pop_front();
+        ops.clear();
+        generator.generate_relevant_ops(successor, ops);
+
+        for (OperatorID op : ops) {
+            size_t num_states = registry.size();
+            StateID predecessor =
+                registry.get_predecessor_state(successor, operators[op]);
+            calls.push_back({successor.get_id(), op, predecessor});
+            if (registry.size() > num_states)
+                queue.push_back(predecessor);
+        }
+    }
+    return calls;
+}
+
+
+template<class Registry>
+void replay(Registry &registry, const vector<PredecessorCall> &calls,
+            const OperatorsProxy &operators) {
+    for (const PredecessorCall &call : calls) {
+        StateID predecessor = registry.get_predecessor_state(
+            registry.lookup_state(call.successor), operators[call.op]);
+        if (predecessor != call.predecessor) {
+            cerr << "replay returned a different predecessor" << endl;
+            exit(1);
+        }
+    }
+}
+
+
+bool have_same_states(const StateRegistry &registry1,
+                      const StateRegistry &registry2) {
+    if (registry1.size() != registry2.size())
+        return false;
+    int num_variables = registry1.get_num_variables();
+    for (StateID id : registry1) {
+        GlobalState state1 = registry1.lookup_state(id);
+        GlobalState state2 = registry2.lookup_state(id);
+        for (int var = 0; var < num_variables; ++var) {
+            if (state1[var] != state2[var])
+                return false;
+        }
+    }
+    return true;
+}
+
+
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 5) {
+        cerr << "usage: " << argv[0]
+             << " output.sas [max_states] [repetitions] [h2_time_limit]"
+             << endl;
+        return 2;
+    }
+    size_t max_states = argc > 2 ? stoul(argv[2]) : 100000;
+    int repetitions = argc > 3 ? stoi(argv[3]) : 20;
+    double h2_time_limit = argc > 4 ? stod(argv[4]) : 0;
+
+    ifstream in(argv[1]);
+    tasks::read_root_task(in);
+
+    const fact_mutex_table::FactMutexTable &mutex_table =
+        fact_mutex_table::FactMutexTable::get_root_mutex_table(h2_time_limit);
+    shared_ptr<AbstractTask> partial_state_task =
+        tasks::PartialStateTask::get_partial_state_task(h2_time_limit);
+    shared_ptr<tasks::RegressionTask> regression_task =
+        tasks::RegressionTask::get_regression_task(h2_time_limit);
+    TaskProxy partial_state_task_proxy(*partial_state_task);
+    TaskProxy regression_task_proxy(*regression_task);
+    OperatorsProxy operators = regression_task_proxy.get_operators();
+    regression_successor_generator::RegressionSuccessorGenerator generator(
+        regression_task);
+    State goal = partial_state_task_proxy.create_state(
+        regression_task->get_goal_state_values());
+
+    OldRegressionStateRegistry old_registry(
+        partial_state_task_proxy, mutex_table);
+    RegressionStateRegistry new_registry(
+        partial_state_task_proxy, mutex_table);
+
+    vector<PredecessorCall> old_calls =
+        regress(old_registry, goal, generator, operators, max_states);
+    vector<PredecessorCall> new_calls =
+        regress(new_registry, goal, generator, operators, max_states);
+
+    int num_pruned = 0;
+    for (size_t i = 0; i < new_calls.size(); ++i) {
+        if (i >= old_calls.size() ||
+            old_calls[i].successor != new_calls[i].successor ||
+            old_calls[i].op != new_calls[i].op ||
+            old_calls[i].predecessor != new_calls[i].predecessor) {
+            cerr << "call " << i << " differs" << endl;
+            return 1;
+        }
+        if (new_calls[i].predecessor == StateID::no_state)
+            ++num_pruned;
+    }
+    if (old_calls.size() != new_calls.size() ||
+        !have_same_states(old_registry, new_registry)) {
+        cerr << "the registries differ" << endl;
+        return 1;
+    }
+    cout << "Both registries return the same predecessors for "
+         << new_calls.size() << " calls (" << num_pruned << " pruned), "
+         << new_registry.size() << " states" << endl;
+    cout << endl;
+
+    benchmark("get_predecessor_state (unordered_set ranges)", repetitions,
+              [&]() {replay(old_registry, old_calls, operators);});
+    benchmark("get_predecessor_state (bitset masks)", repetitions,
+              [&]() {replay(new_registry, new_calls, operators);});
+    return 0;
+}
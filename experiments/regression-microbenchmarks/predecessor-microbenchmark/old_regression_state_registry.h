@@ -0,0 +1,33 @@
+#ifndef OLD_REGRESSION_STATE_REGISTRY_H
+#define OLD_REGRESSION_STATE_REGISTRY_H
+
+#include "state_registry.h"
+#include "task_proxy.h"
+
+#include <utility>
+#include <vector>
+
+namespace fact_mutex_table {
+class FactMutexTable;
+}
+
+/*
+  RegressionStateRegistry::get_predecessor_state as it was before the
+  remaining domains were kept as bitsets: it builds one unordered_set
+  of values per variable for every predecessor that involves mutexes.
+  The mutexes are read from the same FactMutexTable as in the new
+  registry, so only the representation of the domains differs.
+*/
+class OldRegressionStateRegistry : public StateRegistry {
+  std::vector<std::vector<std::vector<std::pair<int, int>>>> fact_to_mutexes;
+
+ public:
+  OldRegressionStateRegistry(
+      const TaskProxy &task_proxy,
+      const fact_mutex_table::FactMutexTable &mutex_table);
+
+  StateID get_predecessor_state(const GlobalState &successor,
+                                const OperatorProxy &op);
+};
+
+#endif
@@ -0,0 +1,130 @@
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "regression/fact_mutex_table.h"
+#include "regression/partial_state_task.h"
+#include "regression/regression_state_registry.h"
+#include "regression/regression_successor_generator.h"
+#include "regression/regression_task.h"
+#include "tasks/root_task.h"
+
+using namespace std;
+using regression_successor_generator::RegressionSuccessorGenerator;
+
+
+void benchmark(const string &desc, int num_calls,
+               const function<void()> &func) {
+    cout << "Running " << desc << " " << num_calls << " times:" << flush;
+    clock_t start = clock();
+    for (int i = 0; i < num_calls; ++i)
+        func();
+    clock_t end = clock();
+    double duration = static_cast<double>(end - start) / CLOCKS_PER_SEC;
+    cout << " " << duration << " seconds" << endl;
+}
+
+
+/*
+  Regress breadth-first from the goal until the registry holds
+  max_states states and return the states in the order of expansion.
+*/
+vector<StateID> regress(
+    RegressionStateRegistry &registry, const State &goal,
+    const RegressionSuccessorGenerator &generator,
+    const OperatorsProxy &operators, size_t max_states) {
+    vector<StateID> expanded;
+    deque<StateID> queue;
+    queue.push_back(registry.create_goal_state(goal).get_id());
+    vector<OperatorID> ops;
+
+    while (!queue.empty() && registry.size() < max_states) {
+        GlobalState state = registry.lookup_state(queue.front());
+        queue.pop_front();
+        expanded.push_back(state.get_id());
+        ops.clear();
+        generator.generate_applicable_ops(state, ops);
+
+        for (OperatorID op : ops) {
+            size_t num_states = registry.size();
+            StateID predecessor =
+                registry.get_predecessor_state(state, operators[op]);
+            if (registry.size() > num_states)
+                queue.push_back(predecessor);
+        }
+    }
+    return expanded;
+}
+
+
+void generate_all(const RegressionSuccessorGenerator &generator,
+                  const RegressionStateRegistry &registry,
+                  const vector<StateID> &states, vector<OperatorID> &ops) {
+    for (StateID id : states) {
+        ops.clear();
+        generator.generate_applicable_ops(registry.lookup_state(id), ops);
+    }
+}
+
+
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 4) {
+        cerr << "usage: " << argv[0]
+             << " output.sas [max_states] [repetitions]" << endl;
+        return 2;
+    }
+    size_t max_states = argc > 2 ? stoul(argv[2]) : 100000;
+    int repetitions = argc > 3 ? stoi(argv[3]) : 200;
+
+    ifstream in(argv[1]);
+    tasks::read_root_task(in);
+
+    shared_ptr<AbstractTask> partial_state_task =
+        tasks::PartialStateTask::get_partial_state_task(0);
+    shared_ptr<tasks::RegressionTask> regression_task =
+        tasks::RegressionTask::get_regression_task(0);
+    TaskProxy partial_state_task_proxy(*partial_state_task);
+    TaskProxy regression_task_proxy(*regression_task);
+    OperatorsProxy operators = regression_task_proxy.get_operators();
+    RegressionSuccessorGenerator tree_generator(regression_task, false);
+    RegressionSuccessorGenerator flat_generator(regression_task, true);
+    State goal = partial_state_task_proxy.create_state(
+        regression_task->get_goal_state_values());
+
+    RegressionStateRegistry registry(
+        partial_state_task_proxy,
+        fact_mutex_table::FactMutexTable::get_root_mutex_table(0));
+    vector<StateID> states =
+        regress(registry, goal, tree_generator, operators, max_states);
+
+    vector<OperatorID> tree_ops;
+    vector<OperatorID> flat_ops;
+    size_t num_ops = 0;
+    for (StateID id : states) {
+        GlobalState state = registry.lookup_state(id);
+        tree_ops.clear();
+        flat_ops.clear();
+        tree_generator.generate_applicable_ops(state, tree_ops);
+        flat_generator.generate_applicable_ops(state, flat_ops);
+        if (tree_ops != flat_ops) {
+            cerr << "the generators differ on state " << id << endl;
+            return 1;
+        }
+        num_ops += tree_ops.size();
+    }
+    cout << "Both generators return the same " << num_ops
+         << " operators for " << states.size() << " states" << endl;
+    cout << endl;
+
+    vector<OperatorID> ops;
+    benchmark("generate_applicable_ops (tree)", repetitions,
+              [&]() {generate_all(tree_generator, registry, states, ops);});
+    benchmark("generate_applicable_ops (flat)", repetitions,
+              [&]() {generate_all(flat_generator, registry, states, ops);});
+    return 0;
+}
@@ -124,6 +124,7 @@ fast_downward_plugin(
         utils/system_unix
         utils/system_windows
         utils/timer
+        utils/worker_pool
     CORE_PLUGIN
 )
 
@@ -200,6 +201,14 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME PAIR_HASH_SET
+    HELP "Hash set storing pairs of non-negative integers"
+    SOURCES
+        algorithms/pair_hash_set
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME INT_PACKER
     HELP "Greedy bin packing algorithm to pack integer variables with small domains tightly into memory"
@@ -787,6 +796,7 @@ fast_downward_plugin(
         front_to_front/front_to_front_lifo_open_list
         front_to_front/front_to_front_best_first_open_list
         front_to_front/front_to_front_open_list
+        front_to_front/open_list_bucket
         front_to_front/front_to_front_ff_heuristic
         front_to_front/front_to_front_additive_heuristic
         front_to_front/front_to_front_max_heuristic
@@ -797,6 +807,7 @@ fast_downward_plugin(
         front_to_front/front_to_front_combining_evaluator
         front_to_front/front_to_front_g_evaluator
         front_to_front/front_to_front_heuristic
+        front_to_front/front_to_front_pair_memo
     DEPENDS BIDIRECTIONAL
 )
 
@@ -817,13 +828,20 @@ fast_downward_plugin(
         regression/plugin_regression_eager_greedy
         regression/regression_eager_search
         regression/symbolic_closed
+        regression/fact_mutex_table
+        regression/h2_mutexes
+        regression/achiever_index
         regression/regression_successor_generator
         regression/regression_successor_generator_factory
         regression/regression_successor_generator_internals
+        regression/partial_state_index
+        regression/subsumption_pruning
+        regression/nogood_store
+        regression/memory_budget
         regression/regression_state_registry
         regression/regression_task
         regression/partial_state_task
-    DEPENDS FRONT_TO_FRONT
+    DEPENDS FRONT_TO_FRONT PAIR_HASH_SET
 )
 
 fast_downward_add_plugin_sources(PLANNER_SOURCES)
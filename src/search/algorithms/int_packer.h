@@ -43,6 +43,10 @@ public:
     void set(Bin *buffer, int var, int value) const;
 
     int get_num_bins() const {return num_bins;}
+
+    // Return the bin that stores var and the mask of its bits in that bin.
+    int get_bin_index(int var) const;
+    Bin get_read_mask(int var) const;
 };
 }
 
@@ -0,0 +1,136 @@
+#ifndef ALGORITHMS_PAIR_HASH_SET_H
+#define ALGORITHMS_PAIR_HASH_SET_H
+
+#include "../utils/system.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace pair_hash_set {
+// Marks empty buckets.
+const std::uint64_t EMPTY_KEY = std::numeric_limits<std::uint64_t>::max();
+
+/*
+  Hash set for storing pairs of non-negative integers, such as pairs of
+  state IDs.
+
+  Compared to unordered_set<pair<int, int>> in the standard library,
+  this implementation does not allocate memory per entry. Both integers
+  are packed into one 64-bit key, and all keys are stored in a single
+  vector with open addressing and linear probing. It requires 8 bytes
+  per bucket, so 11-21 bytes per entry with the load factors between
+  3/8 and 3/4 that we maintain.
+
+  EMPTY_KEY, which has all bits set, cannot occur as a key because both
+  integers are non-negative.
+
+  Because of linear probing, the hash function must distribute the keys
+  uniformly. We use the finalizer of MurmurHash3, which mixes all bits
+  of both integers, so that (a, b) and (b, a) do not collide as they do
+  with hash(a) ^ hash(b).
+*/
+class PairHashSet {
+    using KeyType = std::uint64_t;
+
+    static const std::size_t MIN_BUCKETS = 1024;
+
+    std::vector<KeyType> buckets;
+    std::size_t num_entries;
+    int num_resizes;
+
+    static KeyType get_key(int first, int second) {
+        assert(first >= 0 && second >= 0);
+        return (static_cast<KeyType>(first) << 32) |
+               static_cast<std::uint32_t>(second);
+    }
+
+    static KeyType mix(KeyType key) {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        key ^= key >> 33;
+        return key;
+    }
+
+    std::size_t find_bucket(KeyType key) const {
+        // The number of buckets is a power of 2.
+        std::size_t mask = buckets.size() - 1;
+        std::size_t index = mix(key) & mask;
+        while (buckets[index] != key && buckets[index] != EMPTY_KEY) {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    void rehash(std::size_t new_capacity) {
+        std::vector<KeyType> old_buckets(new_capacity, EMPTY_KEY);
+        old_buckets.swap(buckets);
+        for (KeyType key : old_buckets) {
+            if (key != EMPTY_KEY) {
+                buckets[find_bucket(key)] = key;
+            }
+        }
+        ++num_resizes;
+    }
+
+public:
+    PairHashSet()
+        : buckets(MIN_BUCKETS, EMPTY_KEY),
+          num_entries(0),
+          num_resizes(0) {
+    }
+
+    std::size_t size() const {
+        return num_entries;
+    }
+
+    bool contains(int first, int second) const {
+        KeyType key = get_key(first, second);
+        return buckets[find_bucket(key)] == key;
+    }
+
+    // Return true iff the pair was not contained before.
+    bool insert(int first, int second) {
+        KeyType key = get_key(first, second);
+        std::size_t index = find_bucket(key);
+        if (buckets[index] == key) {
+            return false;
+        }
+        buckets[index] = key;
+        ++num_entries;
+        if (4 * num_entries > 3 * buckets.size()) {
+            if (buckets.size() > std::numeric_limits<std::size_t>::max() /
+                (2 * sizeof(KeyType))) {
+                std::cerr << "PairHashSet surpassed maximum capacity."
+                          << std::endl;
+                utils::exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+            }
+            rehash(2 * buckets.size());
+        }
+        return true;
+    }
+
+    std::size_t estimate_memory_in_bytes() const {
+        return buckets.capacity() * sizeof(KeyType);
+    }
+
+    void print_statistics(const std::string &name) const {
+        std::cout << name << " entries: " << num_entries << std::endl;
+        std::cout << name << " load factor: " << num_entries << "/"
+                  << buckets.size() << " = "
+                  << static_cast<double>(num_entries) / buckets.size()
+                  << std::endl;
+        std::cout << name << " resizes: " << num_resizes << std::endl;
+        std::cout << name << " memory: "
+                  << estimate_memory_in_bytes() / 1024 << " KB" << std::endl;
+    }
+};
+}
+
+#endif
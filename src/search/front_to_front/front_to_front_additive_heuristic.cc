@@ -24,6 +24,19 @@ FrontToFrontAdditiveHeuristic::FrontToFrontAdditiveHeuristic(
   if (cache_initial) precompute_exploration(task_proxy.get_initial_state());
 }
 
+FrontToFrontAdditiveHeuristic::FrontToFrontAdditiveHeuristic(
+    const FrontToFrontAdditiveHeuristic &other)
+    : FrontToFrontRelaxationHeuristic(other),
+      did_write_overflow_warning(other.did_write_overflow_warning),
+      cache_initial(other.cache_initial),
+      fall_back_to(other.fall_back_to) {}
+
+shared_ptr<FrontToFrontHeuristic> FrontToFrontAdditiveHeuristic::clone()
+    const {
+  return shared_ptr<FrontToFrontAdditiveHeuristic>(
+      new FrontToFrontAdditiveHeuristic(*this));
+}
+
 void FrontToFrontAdditiveHeuristic::write_overflow_warning() {
   if (!did_write_overflow_warning) {
     // TODO: Should have a planner-wide warning mechanism to handle
@@ -133,8 +146,16 @@ void FrontToFrontAdditiveHeuristic::precompute_exploration(const State &state) {
   }
 }
 
+void FrontToFrontAdditiveHeuristic::explore_from(const State &state) {
+  if (cache_initial || load_cached_exploration(state)) return;
+
+  precompute_exploration(state);
+  cache_exploration(state);
+}
+
 int FrontToFrontAdditiveHeuristic::compute_add_and_ff(const State &state) {
-  if (cache_initial) {
+  if (cache_initial || exploration_cache_size > 0) {
+    explore_from(state);
     for (Proposition &prop : propositions) prop.marked = false;
   } else {
     setup_exploration_queue();
@@ -142,6 +163,10 @@ int FrontToFrontAdditiveHeuristic::compute_add_and_ff(const State &state) {
     relaxed_exploration();
   }
 
+  return sum_goal_costs();
+}
+
+int FrontToFrontAdditiveHeuristic::sum_goal_costs() {
   int total_cost = 0;
   for (PropID goal_id : goal_propositions) {
     const Proposition *goal = get_proposition(goal_id);
@@ -152,6 +177,10 @@ int FrontToFrontAdditiveHeuristic::compute_add_and_ff(const State &state) {
   return total_cost;
 }
 
+int FrontToFrontAdditiveHeuristic::compute_goal_cost() {
+  return sum_goal_costs();
+}
+
 int FrontToFrontAdditiveHeuristic::compute_heuristic(const State &state) {
   int h = compute_add_and_ff(state);
   if (h != DEAD_END) {
@@ -201,6 +230,11 @@ static shared_ptr<FrontToFrontHeuristic> _parse(OptionParser &parser) {
   parser.document_property("safe", "yes for tasks without axioms");
   parser.document_property("preferred operators", "yes");
   parser.add_option<bool>("cache_initial", "fix initial state", "false");
+  parser.add_option<int>(
+      "exploration_cache_size",
+      "number of source states whose relaxed exploration is kept and "
+      "reused for different goals (0 to disable)",
+      "0", Bounds("0", "infinity"));
 
   vector<string> fall_back_to;
   vector<string> fall_back_to_doc;
@@ -77,10 +77,20 @@ class FrontToFrontAdditiveHeuristic
 
   // Common part of h^add and h^ff computation.
   int compute_add_and_ff(const State &state);
+  int sum_goal_costs();
+
+  virtual void explore_from(const State &state) override;
+  virtual int compute_goal_cost() override;
+  virtual bool falls_back() const override { return fall_back_to != NONE; }
+
+  // The exploration queue is not copied; it is empty between explorations.
+  FrontToFrontAdditiveHeuristic(const FrontToFrontAdditiveHeuristic &other);
 
  public:
   explicit FrontToFrontAdditiveHeuristic(const options::Options &opts);
 
+  virtual std::shared_ptr<FrontToFrontHeuristic> clone() const override;
+
   /*
     TODO: The two methods below are temporarily needed for the CEGAR
     heuristic. In the long run it might be better to split the
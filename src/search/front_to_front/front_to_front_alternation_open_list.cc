@@ -8,6 +8,7 @@
 #include "../utils/system.h"
 
 #include <cassert>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -22,6 +23,11 @@ class FrontToFrontAlternationOpenList : public FrontToFrontOpenList<Entry> {
 
   const int boost_amount;
 
+  // Index of the sublist to remove from next, or -1 if not known.
+  int best;
+
+  int get_best();
+
  protected:
   virtual void do_insertion(EvaluationContext &eval_context, const Entry &entry,
                             bool to_top) override;
@@ -35,17 +41,33 @@ class FrontToFrontAlternationOpenList : public FrontToFrontOpenList<Entry> {
   virtual void clear() override;
   virtual void boost_preferred() override;
   virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+  virtual void get_involved_heuristics(
+      set<FrontToFrontHeuristic *> &heuristics) override;
   virtual bool is_dead_end(EvaluationContext &eval_context) const override;
   virtual bool is_reliable_dead_end(
       EvaluationContext &eval_context) const override;
   virtual pair<int, Entry> get_min_value_and_entry() override;
+  virtual void set_stale_filter(
+      const function<bool(const Entry &)> &filter) override;
+  virtual bool prune_stale_min() override;
   virtual void set_goal(const GlobalState &global_state) override;
+  virtual void print_statistics() const override;
+  virtual void cache_batch(const GlobalState &source,
+                           const vector<GlobalState> &goals,
+                           vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics,
+                           int num_threads) override;
+  virtual void cache_batch(const vector<GlobalState> &sources,
+                           const GlobalState &goal,
+                           vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics,
+                           int num_threads) override;
 };
 
 template <class Entry>
 FrontToFrontAlternationOpenList<Entry>::FrontToFrontAlternationOpenList(
     const Options &opts)
-    : boost_amount(opts.get<int>("boost")) {
+    : boost_amount(opts.get<int>("boost")), best(-1) {
   vector<shared_ptr<FrontToFrontOpenListFactory>> open_list_factories(
       opts.get_list<shared_ptr<FrontToFrontOpenListFactory>>("sublists"));
   open_lists.reserve(open_list_factories.size());
@@ -55,26 +77,37 @@ FrontToFrontAlternationOpenList<Entry>::FrontToFrontAlternationOpenList(
   priorities.resize(open_lists.size(), 0);
 }
 
+template <class Entry>
+int FrontToFrontAlternationOpenList<Entry>::get_best() {
+  if (best == -1) {
+    for (size_t i = 0; i < open_lists.size(); ++i) {
+      if (!open_lists[i]->empty() &&
+          (best == -1 || priorities[i] < priorities[best])) {
+        best = i;
+      }
+    }
+  }
+  return best;
+}
+
 template <class Entry>
 void FrontToFrontAlternationOpenList<Entry>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry, bool to_top) {
-  for (const auto &sublist : open_lists)
+  for (const auto &sublist : open_lists) {
+    // A sublist that becomes non-empty may be the new best one.
+    if (sublist->empty()) best = -1;
     sublist->insert(eval_context, entry, to_top);
+  }
 }
 
 template <class Entry>
 Entry FrontToFrontAlternationOpenList<Entry>::remove_min() {
-  int best = -1;
-  for (size_t i = 0; i < open_lists.size(); ++i) {
-    if (!open_lists[i]->empty() &&
-        (best == -1 || priorities[i] < priorities[best])) {
-      best = i;
-    }
-  }
-  assert(best != -1);
-  const auto &best_list = open_lists[best];
+  int i = get_best();
+  assert(i != -1);
+  const auto &best_list = open_lists[i];
   assert(!best_list->empty());
-  ++priorities[best];
+  ++priorities[i];
+  best = -1;
   return best_list->remove_min();
 }
 
@@ -88,6 +121,7 @@ bool FrontToFrontAlternationOpenList<Entry>::empty() const {
 template <class Entry>
 void FrontToFrontAlternationOpenList<Entry>::clear() {
   for (const auto &sublist : open_lists) sublist->clear();
+  best = -1;
 }
 
 template <class Entry>
@@ -95,6 +129,7 @@ void FrontToFrontAlternationOpenList<Entry>::boost_preferred() {
   for (size_t i = 0; i < open_lists.size(); ++i)
     if (open_lists[i]->only_contains_preferred_entries())
       priorities[i] -= boost_amount;
+  best = -1;
 }
 
 template <class Entry>
@@ -104,6 +139,13 @@ void FrontToFrontAlternationOpenList<Entry>::get_path_dependent_evaluators(
     sublist->get_path_dependent_evaluators(evals);
 }
 
+template <class Entry>
+void FrontToFrontAlternationOpenList<Entry>::get_involved_heuristics(
+    set<FrontToFrontHeuristic *> &heuristics) {
+  for (const auto &sublist : open_lists)
+    sublist->get_involved_heuristics(heuristics);
+}
+
 template <class Entry>
 bool FrontToFrontAlternationOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
@@ -126,25 +168,62 @@ bool FrontToFrontAlternationOpenList<Entry>::is_reliable_dead_end(
 template <class Entry>
 pair<int, Entry>
 FrontToFrontAlternationOpenList<Entry>::get_min_value_and_entry() {
-  int best = -1;
-  for (size_t i = 0; i < open_lists.size(); ++i) {
-    if (!open_lists[i]->empty() &&
-        (best == -1 || priorities[i] < priorities[best])) {
-      best = i;
-    }
-  }
-  assert(best != -1);
-  const auto &best_list = open_lists[best];
+  int i = get_best();
+  assert(i != -1);
+  const auto &best_list = open_lists[i];
   assert(!best_list->empty());
   return best_list->get_min_value_and_entry();
 }
 
+template <class Entry>
+void FrontToFrontAlternationOpenList<Entry>::set_stale_filter(
+    const function<bool(const Entry &)> &filter) {
+  FrontToFrontOpenList<Entry>::set_stale_filter(filter);
+  for (const auto &sublist : open_lists) sublist->set_stale_filter(filter);
+}
+
+template <class Entry>
+bool FrontToFrontAlternationOpenList<Entry>::prune_stale_min() {
+  /*
+    Prune only the sublist that get_min_value_and_entry reads, without
+    changing the priorities as remove_min would.
+  */
+  while (get_best() != -1) {
+    if (open_lists[best]->prune_stale_min()) return true;
+    best = -1;
+  }
+  return false;
+}
+
 template <class Entry>
 void FrontToFrontAlternationOpenList<Entry>::set_goal(
     const GlobalState &global_state) {
   for (const auto &sublist : open_lists) sublist->set_goal(global_state);
 }
 
+template <class Entry>
+void FrontToFrontAlternationOpenList<Entry>::print_statistics() const {
+  for (const auto &sublist : open_lists) sublist->print_statistics();
+}
+
+template <class Entry>
+void FrontToFrontAlternationOpenList<Entry>::cache_batch(
+    const GlobalState &source, const vector<GlobalState> &goals,
+    vector<EvaluatorCache> &caches, SearchStatistics *statistics,
+    int num_threads) {
+  for (const auto &sublist : open_lists)
+    sublist->cache_batch(source, goals, caches, statistics, num_threads);
+}
+
+template <class Entry>
+void FrontToFrontAlternationOpenList<Entry>::cache_batch(
+    const vector<GlobalState> &sources, const GlobalState &goal,
+    vector<EvaluatorCache> &caches, SearchStatistics *statistics,
+    int num_threads) {
+  for (const auto &sublist : open_lists)
+    sublist->cache_batch(sources, goal, caches, statistics, num_threads);
+}
+
 FrontToFrontAlternationOpenListFactory::FrontToFrontAlternationOpenListFactory(
     const Options &options)
     : options(options) {}
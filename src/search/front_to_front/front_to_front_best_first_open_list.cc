@@ -4,24 +4,37 @@
 #include "../plugin.h"
 #include "front_to_front_heuristic.h"
 #include "front_to_front_open_list.h"
+#include "open_list_bucket.h"
 
 #include "../utils/memory.h"
 
 #include <cassert>
-#include <deque>
 #include <map>
 #include <utility>
+#include <vector>
 
 using namespace std;
 
 namespace front_to_front_best_first_open_list {
 template <class Entry>
 class FrontToFrontBestFirstOpenList : public FrontToFrontOpenList<Entry> {
-  typedef deque<Entry> Bucket;
+  using Bucket = open_list_bucket::Bucket<Entry>;
 
-  map<int, Bucket> buckets;
+  // Keys in [0, MAX_DENSE_KEY) index buckets directly.
+  static const int MAX_DENSE_KEY = 1 << 16;
+
+  vector<Bucket> buckets;
+  // Buckets of keys outside of the dense range.
+  map<int, Bucket> sparse_buckets;
+  // No bucket with a smaller key than min_key is non-empty.
+  int min_key;
+  int num_dense_entries;
   int size;
 
+  Bucket &get_bucket(int key);
+  // Return the non-empty bucket with the smallest key.
+  pair<int, Bucket *> get_min_bucket();
+
   shared_ptr<FrontToFrontHeuristic> evaluator;
 
  protected:
@@ -38,17 +51,32 @@ class FrontToFrontBestFirstOpenList : public FrontToFrontOpenList<Entry> {
   virtual bool empty() const override;
   virtual void clear() override;
   virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+  virtual void get_involved_heuristics(
+      set<FrontToFrontHeuristic *> &heuristics) override;
   virtual bool is_dead_end(EvaluationContext &eval_context) const override;
   virtual bool is_reliable_dead_end(
       EvaluationContext &eval_context) const override;
   virtual pair<int, Entry> get_min_value_and_entry() override;
   virtual void set_goal(const GlobalState &global_state) override;
+  virtual void print_statistics() const override;
+  virtual void cache_batch(const GlobalState &source,
+                           const vector<GlobalState> &goals,
+                           vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics,
+                           int num_threads) override;
+  virtual void cache_batch(const vector<GlobalState> &sources,
+                           const GlobalState &goal,
+                           vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics,
+                           int num_threads) override;
 };
 
 template <class Entry>
 FrontToFrontBestFirstOpenList<Entry>::FrontToFrontBestFirstOpenList(
     const Options &opts)
     : FrontToFrontOpenList<Entry>(opts.get<bool>("pref_only")),
+      min_key(0),
+      num_dense_entries(0),
       size(0),
       evaluator(opts.get<shared_ptr<FrontToFrontHeuristic>>("eval")) {}
 
@@ -56,30 +84,62 @@ template <class Entry>
 FrontToFrontBestFirstOpenList<Entry>::FrontToFrontBestFirstOpenList(
     const shared_ptr<FrontToFrontHeuristic> &evaluator, bool preferred_only)
     : FrontToFrontOpenList<Entry>(preferred_only),
+      min_key(0),
+      num_dense_entries(0),
       size(0),
       evaluator(evaluator) {}
 
+template <class Entry>
+typename FrontToFrontBestFirstOpenList<Entry>::Bucket &
+FrontToFrontBestFirstOpenList<Entry>::get_bucket(int key) {
+  if (key < 0 || key >= MAX_DENSE_KEY) return sparse_buckets[key];
+
+  if (key >= static_cast<int>(buckets.size())) buckets.resize(key + 1);
+  if (num_dense_entries == 0 || key < min_key) min_key = key;
+  ++num_dense_entries;
+  return buckets[key];
+}
+
+template <class Entry>
+pair<int, typename FrontToFrontBestFirstOpenList<Entry>::Bucket *>
+FrontToFrontBestFirstOpenList<Entry>::get_min_bucket() {
+  assert(size > 0);
+
+  // Negative keys are sparse and precede all dense keys.
+  if (num_dense_entries == 0 ||
+      (!sparse_buckets.empty() && sparse_buckets.begin()->first < 0)) {
+    auto it = sparse_buckets.begin();
+    assert(it != sparse_buckets.end());
+    return make_pair(it->first, &it->second);
+  }
+
+  while (buckets[min_key].empty()) ++min_key;
+  return make_pair(min_key, &buckets[min_key]);
+}
+
 template <class Entry>
 void FrontToFrontBestFirstOpenList<Entry>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry, bool to_top) {
   int key = eval_context.get_evaluator_value(evaluator.get());
+  Bucket &bucket = get_bucket(key);
   if (to_top)
-    buckets[key].push_front(entry);
+    bucket.push_front(entry);
   else
-    buckets[key].push_back(entry);
+    bucket.push_back(entry);
   ++size;
 }
 
 template <class Entry>
 Entry FrontToFrontBestFirstOpenList<Entry>::remove_min() {
-  assert(size > 0);
-  auto it = buckets.begin();
-  assert(it != buckets.end());
-  Bucket &bucket = it->second;
+  pair<int, Bucket *> min_bucket = get_min_bucket();
+  Bucket &bucket = *min_bucket.second;
   assert(!bucket.empty());
   Entry result = bucket.front();
   bucket.pop_front();
-  if (bucket.empty()) buckets.erase(it);
+  if (min_bucket.first >= 0 && min_bucket.first < MAX_DENSE_KEY)
+    --num_dense_entries;
+  else if (bucket.empty())
+    sparse_buckets.erase(min_bucket.first);
   --size;
   return result;
 }
@@ -92,6 +152,9 @@ bool FrontToFrontBestFirstOpenList<Entry>::empty() const {
 template <class Entry>
 void FrontToFrontBestFirstOpenList<Entry>::clear() {
   buckets.clear();
+  sparse_buckets.clear();
+  min_key = 0;
+  num_dense_entries = 0;
   size = 0;
 }
 
@@ -101,6 +164,12 @@ void FrontToFrontBestFirstOpenList<Entry>::get_path_dependent_evaluators(
   evaluator->get_path_dependent_evaluators(evals);
 }
 
+template <class Entry>
+void FrontToFrontBestFirstOpenList<Entry>::get_involved_heuristics(
+    set<FrontToFrontHeuristic *> &heuristics) {
+  evaluator->get_involved_heuristics(heuristics);
+}
+
 template <class Entry>
 bool FrontToFrontBestFirstOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
@@ -116,14 +185,10 @@ bool FrontToFrontBestFirstOpenList<Entry>::is_reliable_dead_end(
 template <class Entry>
 pair<int, Entry>
 FrontToFrontBestFirstOpenList<Entry>::get_min_value_and_entry() {
-  assert(size > 0);
-  auto it = buckets.begin();
-  assert(it != buckets.end());
-  Bucket &bucket = it->second;
-  assert(!bucket.empty());
-  Entry result = bucket.front();
+  pair<int, Bucket *> min_bucket = get_min_bucket();
+  assert(!min_bucket.second->empty());
 
-  return make_pair(it->first, result);
+  return make_pair(min_bucket.first, min_bucket.second->front());
 }
 
 template <class Entry>
@@ -132,6 +197,27 @@ void FrontToFrontBestFirstOpenList<Entry>::set_goal(
   evaluator->set_goal(global_state);
 }
 
+template <class Entry>
+void FrontToFrontBestFirstOpenList<Entry>::print_statistics() const {
+  evaluator->print_statistics();
+}
+
+template <class Entry>
+void FrontToFrontBestFirstOpenList<Entry>::cache_batch(
+    const GlobalState &source, const vector<GlobalState> &goals,
+    vector<EvaluatorCache> &caches, SearchStatistics *statistics,
+    int num_threads) {
+  evaluator->cache_batch(source, goals, caches, statistics, num_threads);
+}
+
+template <class Entry>
+void FrontToFrontBestFirstOpenList<Entry>::cache_batch(
+    const vector<GlobalState> &sources, const GlobalState &goal,
+    vector<EvaluatorCache> &caches, SearchStatistics *statistics,
+    int num_threads) {
+  evaluator->cache_batch(sources, goal, caches, statistics, num_threads);
+}
+
 FrontToFrontBestFirstOpenListFactory::FrontToFrontBestFirstOpenListFactory(
     const Options &options)
     : options(options) {}
@@ -166,11 +252,14 @@ static shared_ptr<FrontToFrontOpenListFactory> _parse(OptionParser &parser) {
       "Open list that uses a single evaluator and FIFO tiebreaking.");
   parser.document_note(
       "Implementation Notes",
-      "Elements with the same evaluator value are stored in double-ended "
-      "queues, called \"buckets\". The open list stores a map from evaluator "
-      "values to buckets. Pushing and popping from a bucket runs in constant "
-      "time. Therefore, inserting and removing an entry from the open list "
-      "takes time O(log(n)), where n is the number of buckets.");
+      "Elements with the same evaluator value are stored in FIFO queues, "
+      "called \"buckets\", that allocate no memory while they are empty. "
+      "The open list stores the buckets of evaluator values below 2^16 in "
+      "a vector indexed by the value, grown to the largest value seen, and "
+      "remembers the smallest value with a non-empty bucket. Inserting an "
+      "entry takes constant time, and removing the minimum takes time "
+      "amortized O(1 + d), where d is the distance to the next non-empty "
+      "bucket. Larger values are stored in a map from values to buckets.");
   parser.add_option<shared_ptr<FrontToFrontHeuristic>>(
       "eval", "front_to_front_heuristic");
   parser.add_option<bool>("pref_only",
@@ -186,4 +275,6 @@ static shared_ptr<FrontToFrontOpenListFactory> _parse(OptionParser &parser) {
 
 static Plugin<FrontToFrontOpenListFactory> _plugin("front_to_front_single",
                                                    _parse);
+template <class Entry>
+const int FrontToFrontBestFirstOpenList<Entry>::MAX_DENSE_KEY;
 }  // namespace front_to_front_best_first_open_list
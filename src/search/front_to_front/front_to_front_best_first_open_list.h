@@ -7,7 +7,8 @@
 /*
   Open list indexed by a single int, using FIFO tie-breaking.
 
-  Implemented as a map from int to deques.
+  Implemented as a vector of deques indexed by the int, with a map from
+  int to deques for values outside of the vector range.
 */
 
 namespace front_to_front_best_first_open_list {
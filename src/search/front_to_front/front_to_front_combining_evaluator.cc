@@ -17,6 +17,15 @@ FrontToFrontCombiningEvaluator::FrontToFrontCombiningEvaluator(
 
 FrontToFrontCombiningEvaluator::~FrontToFrontCombiningEvaluator() {}
 
+vector<shared_ptr<FrontToFrontHeuristic>>
+FrontToFrontCombiningEvaluator::clone_subevaluators() const {
+  vector<shared_ptr<FrontToFrontHeuristic>> clones;
+  clones.reserve(subevaluators.size());
+  for (const shared_ptr<FrontToFrontHeuristic> &subevaluator : subevaluators)
+    clones.push_back(subevaluator->clone());
+  return clones;
+}
+
 bool FrontToFrontCombiningEvaluator::dead_ends_are_reliable() const {
   return all_dead_ends_are_reliable;
 }
@@ -51,8 +60,35 @@ void FrontToFrontCombiningEvaluator::get_path_dependent_evaluators(
     subevaluator->get_path_dependent_evaluators(evals);
 }
 
+void FrontToFrontCombiningEvaluator::get_involved_heuristics(
+    set<FrontToFrontHeuristic *> &heuristics) {
+  heuristics.insert(this);
+  for (auto &subevaluator : subevaluators)
+    subevaluator->get_involved_heuristics(heuristics);
+}
+
 void FrontToFrontCombiningEvaluator::set_goal(const GlobalState &state) {
   for (auto &subevaluator : subevaluators) subevaluator->set_goal(state);
 }
 
+void FrontToFrontCombiningEvaluator::print_statistics() const {
+  for (auto &subevaluator : subevaluators) subevaluator->print_statistics();
+}
+
+void FrontToFrontCombiningEvaluator::cache_batch(
+    const GlobalState &source, const vector<GlobalState> &goals,
+    vector<EvaluatorCache> &caches, SearchStatistics *statistics,
+    int num_threads) {
+  for (auto &subevaluator : subevaluators)
+    subevaluator->cache_batch(source, goals, caches, statistics, num_threads);
+}
+
+void FrontToFrontCombiningEvaluator::cache_batch(
+    const vector<GlobalState> &sources, const GlobalState &goal,
+    vector<EvaluatorCache> &caches, SearchStatistics *statistics,
+    int num_threads) {
+  for (auto &subevaluator : subevaluators)
+    subevaluator->cache_batch(sources, goal, caches, statistics, num_threads);
+}
+
 }  // namespace front_to_front_combining_evaluator
@@ -24,6 +24,9 @@ class FrontToFrontCombiningEvaluator : public FrontToFrontHeuristic {
     return NO_VALUE;
   }
 
+  std::vector<std::shared_ptr<FrontToFrontHeuristic>> clone_subevaluators()
+      const;
+
  public:
   explicit FrontToFrontCombiningEvaluator(
       const std::vector<std::shared_ptr<FrontToFrontHeuristic>>
@@ -31,6 +34,7 @@ class FrontToFrontCombiningEvaluator : public FrontToFrontHeuristic {
   virtual ~FrontToFrontCombiningEvaluator() override;
 
   virtual void set_goal(const GlobalState &state) override;
+  virtual void print_statistics() const override;
 
   /*
     Note: dead_ends_are_reliable() is a state-independent method, so
@@ -51,6 +55,19 @@ class FrontToFrontCombiningEvaluator : public FrontToFrontHeuristic {
 
   virtual void get_path_dependent_evaluators(
       std::set<Evaluator *> &evals) override;
+  virtual void get_involved_heuristics(
+      std::set<FrontToFrontHeuristic *> &heuristics) override;
+
+  virtual void cache_batch(const GlobalState &source,
+                           const std::vector<GlobalState> &goals,
+                           std::vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics,
+                           int num_threads) override;
+  virtual void cache_batch(const std::vector<GlobalState> &sources,
+                           const GlobalState &goal,
+                           std::vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics,
+                           int num_threads) override;
 };
 }  // namespace front_to_front_combining_evaluator
 
@@ -18,8 +18,12 @@ FrontToFrontFFHeuristic::FrontToFrontFFHeuristic(const Options &opts)
   cout << "Initializing FF heuristic..." << endl;
 }
 
+shared_ptr<FrontToFrontHeuristic> FrontToFrontFFHeuristic::clone() const {
+  return shared_ptr<FrontToFrontFFHeuristic>(new FrontToFrontFFHeuristic(*this));
+}
+
 void FrontToFrontFFHeuristic::mark_preferred_operators_and_relaxed_plan(
-    const State &state, PropID goal_id) {
+    PropID goal_id) {
   Proposition *goal = get_proposition(goal_id);
   if (!goal->marked) {  // Only consider each subgoal once.
     // cout << goal_id << " is not marked" << endl;
@@ -28,7 +32,7 @@ void FrontToFrontFFHeuristic::mark_preferred_operators_and_relaxed_plan(
     if (op_id != NO_OP) {  // We have not yet chained back to a start node.
       UnaryOperator *unary_op = get_operator(op_id);
       for (PropID precond : get_preconditions(op_id)) {
-        mark_preferred_operators_and_relaxed_plan(state, precond);
+        mark_preferred_operators_and_relaxed_plan(precond);
       }
       int operator_no = unary_op->operator_no;
       if (operator_no != -1) {
@@ -45,7 +49,7 @@ void FrontToFrontFFHeuristic::mark_preferred_operators_and_relaxed_plan(
 
 int FrontToFrontFFHeuristic::compute_heuristic(
     const GlobalState &global_state) {
-  State state = convert_global_state(global_state);
+  const State &state = convert_global_state(global_state);
   int h_add = compute_add_and_ff(state);
   bool reset_goal = false;
 
@@ -57,7 +61,7 @@ int FrontToFrontFFHeuristic::compute_heuristic(
       if (h_add == DEAD_END) return h_add;
 
       for (PropID goal_id : goal_propositions)
-        mark_preferred_operators_and_relaxed_plan(initial_state, goal_id);
+        mark_preferred_operators_and_relaxed_plan(goal_id);
     } else if (fall_back_to == GOAL) {
       set_original_goal();
       h_add = compute_add_and_ff(state);
@@ -70,17 +74,25 @@ int FrontToFrontFFHeuristic::compute_heuristic(
       reset_goal = true;
 
       for (PropID goal_id : goal_propositions)
-        mark_preferred_operators_and_relaxed_plan(state, goal_id);
+        mark_preferred_operators_and_relaxed_plan(goal_id);
     } else {
       return h_add;
     }
   } else {
     // cout << "start marking" << endl;
     for (PropID goal_id : goal_propositions)
-      mark_preferred_operators_and_relaxed_plan(state, goal_id);
+      mark_preferred_operators_and_relaxed_plan(goal_id);
     // cout << "end marking" << endl;
   }
 
+  int h_ff = compute_relaxed_plan_cost();
+
+  if (reset_goal) do_set_goal();
+
+  return h_ff;
+}
+
+int FrontToFrontFFHeuristic::compute_relaxed_plan_cost() {
   int h_ff = 0;
   for (size_t op_no = 0; op_no < relaxed_plan.size(); ++op_no) {
     if (relaxed_plan[op_no]) {
@@ -88,10 +100,17 @@ int FrontToFrontFFHeuristic::compute_heuristic(
       h_ff += task_proxy.get_operators()[op_no].get_cost();
     }
   }
+  return h_ff;
+}
 
-  if (reset_goal) do_set_goal();
+int FrontToFrontFFHeuristic::compute_goal_cost() {
+  for (Proposition &prop : propositions) prop.marked = false;
+  if (sum_goal_costs() == DEAD_END) return DEAD_END;
 
-  return h_ff;
+  for (PropID goal_id : goal_propositions)
+    mark_preferred_operators_and_relaxed_plan(goal_id);
+
+  return compute_relaxed_plan_cost();
 }
 
 static shared_ptr<FrontToFrontHeuristic> _parse(OptionParser &parser) {
@@ -108,6 +127,11 @@ static shared_ptr<FrontToFrontHeuristic> _parse(OptionParser &parser) {
   parser.document_property("safe", "yes for tasks without axioms");
   parser.document_property("preferred operators", "yes");
   parser.add_option<bool>("cache_initial", "fix initial state", "false");
+  parser.add_option<int>(
+      "exploration_cache_size",
+      "number of source states whose relaxed exploration is kept and "
+      "reused for different goals (0 to disable)",
+      "0", Bounds("0", "infinity"));
 
   vector<string> fall_back_to;
   vector<string> fall_back_to_doc;
@@ -28,14 +28,17 @@ class FrontToFrontFFHeuristic
   // as a bit vector.
   using RelaxedPlan = std::vector<bool>;
   RelaxedPlan relaxed_plan;
-  void mark_preferred_operators_and_relaxed_plan(const State &state,
-                                                 PropID goal_id);
+  void mark_preferred_operators_and_relaxed_plan(PropID goal_id);
+  int compute_relaxed_plan_cost();
 
  protected:
   virtual int compute_heuristic(const GlobalState &global_state) override;
+  virtual int compute_goal_cost() override;
 
  public:
   explicit FrontToFrontFFHeuristic(const options::Options &opts);
+
+  virtual std::shared_ptr<FrontToFrontHeuristic> clone() const override;
 };
 }  // namespace front_to_front_ff_heuristic
 
@@ -22,6 +22,19 @@ class FrontToFrontGEvaluator : public FrontToFrontHeuristic {
 
   virtual void set_goal(const GlobalState &state) override {}
 
+  virtual std::shared_ptr<FrontToFrontHeuristic> clone() const override {
+    return std::make_shared<FrontToFrontGEvaluator>(*this);
+  }
+
+  // The g value is not known in batches, but it is cheap to compute later.
+  virtual void cache_batch(const GlobalState &,
+                           const std::vector<GlobalState> &,
+                           std::vector<EvaluatorCache> &,
+                           SearchStatistics *, int) override {}
+  virtual void cache_batch(const std::vector<GlobalState> &,
+                           const GlobalState &, std::vector<EvaluatorCache> &,
+                           SearchStatistics *, int) override {}
+
   virtual EvaluationResult compute_result(
       EvaluationContext &eval_context) override;
 
@@ -13,18 +13,53 @@ FrontToFrontGoalCountHeuristic::FrontToFrontGoalCountHeuristic(
   cout << "Initializing goal count heuristic..." << endl;
 }
 
-int FrontToFrontGoalCountHeuristic::compute_heuristic(
-    const GlobalState &global_state) {
-  const State state = convert_global_state(global_state);
+shared_ptr<FrontToFrontHeuristic> FrontToFrontGoalCountHeuristic::clone()
+    const {
+  return shared_ptr<FrontToFrontGoalCountHeuristic>(
+      new FrontToFrontGoalCountHeuristic(*this));
+}
+
+int FrontToFrontGoalCountHeuristic::count_unsatisfied_goals(
+    const State &state, const vector<pair<int, int>> &goal) const {
   int unsatisfied_goal_count = 0;
 
-  for (auto goal : current_goal) {
-    if (state.get_values()[goal.first] != goal.second) ++unsatisfied_goal_count;
+  for (auto fact : goal) {
+    if (state.get_values()[fact.first] != fact.second) ++unsatisfied_goal_count;
   }
 
   return unsatisfied_goal_count;
 }
 
+int FrontToFrontGoalCountHeuristic::compute_heuristic(
+    const GlobalState &global_state) {
+  return count_unsatisfied_goals(convert_global_state(global_state),
+                                 current_goal);
+}
+
+void FrontToFrontGoalCountHeuristic::compute_heuristic_batch(
+    const GlobalState &source, const vector<GlobalState> &goals,
+    vector<int> &values) {
+  const State &state = convert_global_state(source);
+
+  for (const GlobalState &goal : goals) {
+    if (cache_goal)
+      values.push_back(count_unsatisfied_goals(state, current_goal));
+    else
+      values.push_back(count_unsatisfied_goals(state, get_goal_facts(goal)));
+  }
+}
+
+void FrontToFrontGoalCountHeuristic::compute_heuristic_batch(
+    const vector<GlobalState> &sources, const GlobalState &goal,
+    vector<int> &values) {
+  const vector<pair<int, int>> &goal_facts =
+      cache_goal ? current_goal : get_goal_facts(goal);
+
+  for (const GlobalState &source : sources)
+    values.push_back(
+        count_unsatisfied_goals(convert_global_state(source), goal_facts));
+}
+
 static shared_ptr<FrontToFrontHeuristic> _parse(OptionParser &parser) {
   parser.document_synopsis("Goal count heuristic", "");
   parser.document_language_support("action costs", "ignored by design");
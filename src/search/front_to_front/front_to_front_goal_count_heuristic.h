@@ -5,13 +5,27 @@
 #include "../state_id.h"
 #include "front_to_front_heuristic.h"
 
+#include <utility>
+#include <vector>
+
 namespace front_to_front_goal_count_heuristic {
 class FrontToFrontGoalCountHeuristic : public FrontToFrontHeuristic {
+  int count_unsatisfied_goals(
+      const State &state, const std::vector<std::pair<int, int>> &goal) const;
+
  protected:
   virtual int compute_heuristic(const GlobalState &global_state) override;
+  virtual void compute_heuristic_batch(const GlobalState &source,
+                                       const std::vector<GlobalState> &goals,
+                                       std::vector<int> &values) override;
+  virtual void compute_heuristic_batch(const std::vector<GlobalState> &sources,
+                                       const GlobalState &goal,
+                                       std::vector<int> &values) override;
 
  public:
   explicit FrontToFrontGoalCountHeuristic(const options::Options &opts);
+
+  virtual std::shared_ptr<FrontToFrontHeuristic> clone() const override;
 };
 }  // namespace front_to_front_goal_count_heuristic
 
@@ -19,6 +19,12 @@ FrontToFrontGreater::FrontToFrontGreater(const Options &opts)
 
 FrontToFrontGreater::~FrontToFrontGreater() {}
 
+shared_ptr<FrontToFrontHeuristic> FrontToFrontGreater::clone() const {
+  shared_ptr<FrontToFrontGreater> greater(new FrontToFrontGreater(*this));
+  greater->evaluator = evaluator->clone();
+  return greater;
+}
+
 EvaluationResult FrontToFrontGreater::compute_result(
     EvaluationContext &eval_context) {
   EvaluationResult result = evaluator->compute_result(eval_context);
@@ -34,6 +40,32 @@ void FrontToFrontGreater::set_goal(const GlobalState &state) {
   evaluator->set_goal(state);
 }
 
+void FrontToFrontGreater::print_statistics() const {
+  evaluator->print_statistics();
+}
+
+void FrontToFrontGreater::invert_values(const vector<int> &sub_values,
+                                        vector<int> &values) const {
+  for (int value : sub_values) {
+    if (value == EvaluationResult::INFTY)
+      values.push_back(DEAD_END);
+    else
+      values.push_back(INFTY - value);
+  }
+}
+
+void FrontToFrontGreater::compute_heuristic_batch(
+    const GlobalState &source, const vector<GlobalState> &goals,
+    vector<int> &values) {
+  invert_values(evaluator->evaluate_batch(source, goals), values);
+}
+
+void FrontToFrontGreater::compute_heuristic_batch(
+    const vector<GlobalState> &sources, const GlobalState &goal,
+    vector<int> &values) {
+  invert_values(evaluator->evaluate_batch(sources, goal), values);
+}
+
 bool FrontToFrontGreater::dead_ends_are_reliable() const {
   return evaluator->dead_ends_are_reliable();
 }
@@ -43,6 +75,12 @@ void FrontToFrontGreater::get_path_dependent_evaluators(
   evaluator->get_path_dependent_evaluators(evals);
 }
 
+void FrontToFrontGreater::get_involved_heuristics(
+    set<FrontToFrontHeuristic *> &heuristics) {
+  heuristics.insert(this);
+  evaluator->get_involved_heuristics(heuristics);
+}
+
 static shared_ptr<FrontToFrontHeuristic> _parse(OptionParser &parser) {
   parser.document_synopsis(
       "Weighted evaluator",
@@ -4,6 +4,7 @@
 #include "front_to_front_heuristic.h"
 
 #include <memory>
+#include <vector>
 
 namespace options {
 class Options;
@@ -13,10 +14,19 @@ namespace front_to_front_greater {
 class FrontToFrontGreater : public FrontToFrontHeuristic {
   std::shared_ptr<FrontToFrontHeuristic> evaluator;
 
+  void invert_values(const std::vector<int> &sub_values,
+                     std::vector<int> &values) const;
+
  protected:
   virtual int compute_heuristic(const GlobalState &state) override {
     return DEAD_END;
   };
+  virtual void compute_heuristic_batch(const GlobalState &source,
+                                       const std::vector<GlobalState> &goals,
+                                       std::vector<int> &values) override;
+  virtual void compute_heuristic_batch(const std::vector<GlobalState> &sources,
+                                       const GlobalState &goal,
+                                       std::vector<int> &values) override;
 
  public:
   static const int INFTY;
@@ -24,11 +34,16 @@ class FrontToFrontGreater : public FrontToFrontHeuristic {
   explicit FrontToFrontGreater(const options::Options &opts);
   virtual ~FrontToFrontGreater() override;
 
+  virtual std::shared_ptr<FrontToFrontHeuristic> clone() const override;
+
   virtual void set_goal(const GlobalState &state);
+  virtual void print_statistics() const override;
 
   virtual bool dead_ends_are_reliable() const override;
   virtual void get_path_dependent_evaluators(
       std::set<Evaluator *> &evals) override;
+  virtual void get_involved_heuristics(
+      std::set<FrontToFrontHeuristic *> &heuristics) override;
   virtual EvaluationResult compute_result(
       EvaluationContext &eval_context) override;
 };
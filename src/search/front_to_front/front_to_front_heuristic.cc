@@ -2,55 +2,130 @@
 
 #include "../option_parser.h"
 #include "../plugin.h"
+#include "../search_statistics.h"
 #include "../tasks/cost_adapted_task.h"
 #include "../tasks/root_task.h"
+#include "../utils/memory.h"
+#include "../utils/worker_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
 
 using namespace std;
 
 FrontToFrontHeuristic::FrontToFrontHeuristic()
-    : cache_goal(false),
+    : pair_memo(0),
+      goal_registry(nullptr),
+      cache_goal(false),
       partial_state(false),
       task(tasks::g_root_task),
-      task_proxy(*task) {
+      task_proxy(*task),
+      converted_state(task_proxy.create_state(
+          vector<int>(task_proxy.get_variables().size()))),
+      num_conversions(0),
+      num_buffer_allocations(0),
+      num_unchanged_goals(0) {
   for (auto g : task_proxy.get_goals())
     current_goal.push_back(make_pair(g.get_variable().get_id(), g.get_value()));
 }
 
 FrontToFrontHeuristic::FrontToFrontHeuristic(const Options &opts)
     : Evaluator(opts.get_unparsed_config(), true, true, true),
+      pair_memo(opts.get<int>("pair_memo_size")),
+      goal_registry(nullptr),
       cache_goal(opts.get<bool>("cache_goal")),
       partial_state(opts.get<bool>("partial_state")),
       task(opts.get<shared_ptr<AbstractTask>>("transform")),
-      task_proxy(*task) {
+      task_proxy(*task),
+      converted_state(task_proxy.create_state(
+          vector<int>(task_proxy.get_variables().size()))),
+      num_conversions(0),
+      num_buffer_allocations(0),
+      num_unchanged_goals(0) {
   for (auto g : task_proxy.get_goals())
     current_goal.push_back(make_pair(g.get_variable().get_id(), g.get_value()));
 }
 
+FrontToFrontHeuristic::FrontToFrontHeuristic(
+    const FrontToFrontHeuristic &other)
+    : Evaluator(other),
+      pair_memo(other.pair_memo.get_capacity()),
+      goal_id(other.goal_id),
+      goal_registry(other.goal_registry),
+      cache_goal(other.cache_goal),
+      partial_state(other.partial_state),
+      task(other.task),
+      task_proxy(*task),
+      current_goal(other.current_goal),
+      converted_state(task_proxy.create_state(
+          vector<int>(task_proxy.get_variables().size()))),
+      num_conversions(0),
+      num_buffer_allocations(0),
+      num_unchanged_goals(0) {}
+
 FrontToFrontHeuristic::~FrontToFrontHeuristic() {}
 
 void FrontToFrontHeuristic::set_preferred(const OperatorProxy &op) {
   preferred_operators.insert(op.get_ancestor_operator_id(task.get()));
 }
 
-State FrontToFrontHeuristic::convert_global_state(
-    const GlobalState &global_state) const {
-  return task_proxy.convert_ancestor_state(global_state.unpack());
+void FrontToFrontHeuristic::count_buffer_growth(size_t old_capacity,
+                                                size_t new_capacity) {
+  if (new_capacity != old_capacity) ++num_buffer_allocations;
 }
 
-void FrontToFrontHeuristic::set_goal(const GlobalState &global_state) {
-  if (cache_goal) return;
+const State &FrontToFrontHeuristic::convert_global_state(
+    const GlobalState &global_state) {
+  vector<int> values = converted_state.release_values();
+  size_t capacity = values.capacity();
+  global_state.unpack_into(task_proxy, values);
+  count_buffer_growth(capacity, values.capacity());
+  ++num_conversions;
+  converted_state = task_proxy.create_state(move(values));
+  return converted_state;
+}
+
+const vector<pair<int, int>> &FrontToFrontHeuristic::get_goal_facts(
+    const GlobalState &global_state) {
+  size_t values_capacity = goal_values.capacity();
+  size_t facts_capacity = goal_facts.capacity();
+  global_state.unpack_into(task_proxy, goal_values);
+  VariablesProxy variables = task_proxy.get_variables();
+  goal_facts.clear();
+
+  for (size_t var = 0; var < goal_values.size(); ++var) {
+    int value = goal_values[var];
 
-  auto goal_state = task_proxy.convert_ancestor_state(global_state.unpack());
-  current_goal.clear();
+    if (!partial_state || value < variables[var].get_domain_size() - 1)
+      goal_facts.emplace_back(var, value);
+  }
 
-  for (auto f : goal_state) {
-    VariableProxy var = f.get_variable();
-    int value = f.get_value();
+  count_buffer_growth(values_capacity, goal_values.capacity());
+  count_buffer_growth(facts_capacity, goal_facts.capacity());
+  ++num_conversions;
+  return goal_facts;
+}
 
-    if (!partial_state || value < var.get_domain_size() - 1)
-      current_goal.emplace_back(
-          make_pair(f.get_variable().get_id(), f.get_value()));
+bool FrontToFrontHeuristic::update_goal(const GlobalState &global_state) {
+  if (global_state.get_id() == goal_id &&
+      &global_state.get_registry() == goal_registry) {
+    ++num_unchanged_goals;
+    return false;
   }
+
+  get_goal_facts(global_state);
+  // The previous goal becomes the buffer of the next get_goal_facts.
+  swap(current_goal, goal_facts);
+  goal_id = global_state.get_id();
+  goal_registry = &global_state.get_registry();
+  return true;
+}
+
+void FrontToFrontHeuristic::set_goal(const GlobalState &global_state) {
+  if (cache_goal) return;
+
+  update_goal(global_state);
 }
 
 void FrontToFrontHeuristic::add_options_to_parser(OptionParser &parser) {
@@ -61,6 +136,11 @@ void FrontToFrontHeuristic::add_options_to_parser(OptionParser &parser) {
       "no_transform()");
   parser.add_option<bool>("partial_state", "evaluate partial state", "false");
   parser.add_option<bool>("cache_goal", "cache the original goal", "false");
+  parser.add_option<int>(
+      "pair_memo_size",
+      "number of (source, goal) state pairs whose heuristic values are "
+      "memoized; a pair evicts the pair with the same slot (0 to disable)",
+      "0", Bounds("0", "infinity"));
 }
 
 EvaluationResult FrontToFrontHeuristic::compute_result(
@@ -70,8 +150,18 @@ EvaluationResult FrontToFrontHeuristic::compute_result(
   assert(preferred_operators.empty());
 
   const GlobalState &state = eval_context.get_state();
-  int heuristic = compute_heuristic(state);
-  result.set_count_evaluation(true);
+  bool use_memo =
+      pair_memo.is_enabled() && state.get_id() != StateID::no_state;
+  int heuristic = NO_VALUE;
+
+  if (use_memo && !eval_context.get_calculate_preferred() &&
+      pair_memo.lookup(state.get_id(), goal_id, heuristic)) {
+    result.set_count_evaluation(false);
+  } else {
+    heuristic = compute_heuristic(state);
+    if (use_memo) pair_memo.store(state.get_id(), goal_id, heuristic);
+    result.set_count_evaluation(true);
+  }
 
   assert(heuristic == DEAD_END || heuristic >= 0);
 
@@ -94,6 +184,161 @@ EvaluationResult FrontToFrontHeuristic::compute_result(
   return result;
 }
 
+void FrontToFrontHeuristic::print_statistics() const {
+  cout << "State conversions: " << num_conversions << " ("
+       << num_buffer_allocations << " buffer allocations)" << endl;
+  cout << "Unchanged goals: " << num_unchanged_goals << endl;
+  pair_memo.print_statistics();
+}
+
+void FrontToFrontHeuristic::compute_heuristic_batch(
+    const GlobalState &source, const vector<GlobalState> &goals,
+    vector<int> &values) {
+  for (const GlobalState &goal : goals) {
+    set_goal(goal);
+    EvaluationContext eval_context(source);
+    EvaluationResult result = compute_result(eval_context);
+    values.push_back(result.is_infinite() ? DEAD_END
+                                          : result.get_evaluator_value());
+  }
+}
+
+void FrontToFrontHeuristic::compute_heuristic_batch(
+    const vector<GlobalState> &sources, const GlobalState &goal,
+    vector<int> &values) {
+  set_goal(goal);
+
+  for (const GlobalState &source : sources) {
+    EvaluationContext eval_context(source);
+    EvaluationResult result = compute_result(eval_context);
+    values.push_back(result.is_infinite() ? DEAD_END
+                                          : result.get_evaluator_value());
+  }
+}
+
+vector<int> FrontToFrontHeuristic::evaluate_batch(
+    const GlobalState &source, const vector<GlobalState> &goals) {
+  vector<int> values;
+  values.reserve(goals.size());
+  compute_heuristic_batch(source, goals, values);
+  preferred_operators.clear();
+
+  for (int &value : values) {
+    if (value == DEAD_END) value = EvaluationResult::INFTY;
+  }
+
+  return values;
+}
+
+vector<int> FrontToFrontHeuristic::evaluate_batch(
+    const vector<GlobalState> &sources, const GlobalState &goal) {
+  vector<int> values;
+  values.reserve(sources.size());
+  compute_heuristic_batch(sources, goal, values);
+  preferred_operators.clear();
+
+  for (int &value : values) {
+    if (value == DEAD_END) value = EvaluationResult::INFTY;
+  }
+
+  return values;
+}
+
+void FrontToFrontHeuristic::evaluate_chunks(
+    size_t batch_size, int num_threads,
+    const function<void(FrontToFrontHeuristic &, size_t, size_t)>
+        &evaluate_chunk) {
+  size_t num_chunks = min(batch_size, static_cast<size_t>(num_threads));
+  if (num_chunks == 0) return;
+  size_t chunk_size = (batch_size + num_chunks - 1) / num_chunks;
+
+  while (thread_clones.size() + 1 < num_chunks)
+    thread_clones.push_back(clone());
+
+  int num_workers = num_chunks - 1;
+  if (num_workers > 0 &&
+      (!worker_pool || worker_pool->get_num_workers() < num_workers))
+    worker_pool = utils::make_unique_ptr<utils::WorkerPool>(num_workers);
+
+  function<void(int)> job = [&](int i) {
+    size_t begin = i * chunk_size;
+    size_t end = min(batch_size, begin + chunk_size);
+    if (begin >= end) return;
+    FrontToFrontHeuristic &heuristic = i == 0 ? *this : *thread_clones[i - 1];
+    evaluate_chunk(heuristic, begin, end);
+  };
+
+  if (worker_pool)
+    worker_pool->run(static_cast<int>(num_chunks), job);
+  else
+    job(0);
+}
+
+static void store_batch_results(Evaluator *evaluator, const vector<int> &values,
+                                vector<EvaluatorCache> &caches,
+                                SearchStatistics *statistics) {
+  assert(values.size() == caches.size());
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    EvaluationResult &result = caches[i][evaluator];
+    result.set_evaluator_value(values[i]);
+    result.set_count_evaluation(true);
+  }
+
+  if (statistics && evaluator->is_used_for_counting_evaluations())
+    statistics->inc_evaluations(values.size());
+}
+
+void FrontToFrontHeuristic::cache_batch(const GlobalState &source,
+                                        const vector<GlobalState> &goals,
+                                        vector<EvaluatorCache> &caches,
+                                        SearchStatistics *statistics,
+                                        int num_threads) {
+  if (num_threads <= 1) {
+    store_batch_results(this, evaluate_batch(source, goals), caches,
+                        statistics);
+    return;
+  }
+
+  vector<int> values(goals.size());
+  evaluate_chunks(goals.size(), num_threads,
+                  [&](FrontToFrontHeuristic &heuristic, size_t begin,
+                      size_t end) {
+                    vector<GlobalState> chunk(goals.begin() + begin,
+                                              goals.begin() + end);
+                    vector<int> chunk_values =
+                        heuristic.evaluate_batch(source, chunk);
+                    copy(chunk_values.begin(), chunk_values.end(),
+                         values.begin() + begin);
+                  });
+  store_batch_results(this, values, caches, statistics);
+}
+
+void FrontToFrontHeuristic::cache_batch(const vector<GlobalState> &sources,
+                                        const GlobalState &goal,
+                                        vector<EvaluatorCache> &caches,
+                                        SearchStatistics *statistics,
+                                        int num_threads) {
+  if (num_threads <= 1) {
+    store_batch_results(this, evaluate_batch(sources, goal), caches,
+                        statistics);
+    return;
+  }
+
+  vector<int> values(sources.size());
+  evaluate_chunks(sources.size(), num_threads,
+                  [&](FrontToFrontHeuristic &heuristic, size_t begin,
+                      size_t end) {
+                    vector<GlobalState> chunk(sources.begin() + begin,
+                                              sources.begin() + end);
+                    vector<int> chunk_values =
+                        heuristic.evaluate_batch(chunk, goal);
+                    copy(chunk_values.begin(), chunk_values.end(),
+                         values.begin() + begin);
+                  });
+  store_batch_results(this, values, caches, statistics);
+}
+
 static PluginTypePlugin<FrontToFrontHeuristic> _type_plugin(
     "FrontToFrontHeuristic", "front to front heuristic functions",
     "front_to_front_evaluator", "front_to_front_heuristic");
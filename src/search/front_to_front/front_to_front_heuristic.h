@@ -5,11 +5,24 @@
 #include "../evaluation_context.h"
 #include "../evaluation_result.h"
 #include "../evaluator.h"
+#include "../evaluator_cache.h"
 #include "../task_proxy.h"
 
 #include "../algorithms/ordered_set.h"
+#include "front_to_front_pair_memo.h"
 
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <utility>
+#include <vector>
+
+class SearchStatistics;
+class StateRegistry;
+
+namespace utils {
+class WorkerPool;
+}
 
 namespace options {
 class OptionParser;
@@ -18,6 +31,20 @@ class Options;
 
 class FrontToFrontHeuristic : public Evaluator {
   ordered_set::OrderedSet<OperatorID> preferred_operators;
+  // Clones used by cache_batch for all but the first chunk of a batch.
+  std::vector<std::shared_ptr<FrontToFrontHeuristic>> thread_clones;
+  // Runs the chunks of the clones; kept so that batches do not start threads.
+  std::unique_ptr<utils::WorkerPool> worker_pool;
+  // Values of compute_heuristic by (source, goal) pair; see compute_result.
+  front_to_front_pair_memo::PairMemo pair_memo;
+  // The state last passed to set_goal, or no_state if the goal is fixed.
+  StateID goal_id;
+  const StateRegistry *goal_registry;
+
+  void evaluate_chunks(
+      std::size_t batch_size, int num_threads,
+      const std::function<void(FrontToFrontHeuristic &, std::size_t,
+                               std::size_t)> &evaluate_chunk);
 
  protected:
   bool cache_goal;
@@ -26,13 +53,71 @@ class FrontToFrontHeuristic : public Evaluator {
   TaskProxy task_proxy;
   std::vector<std::pair<int, int>> current_goal;
 
+ private:
+  /*
+    Buffers reused by convert_global_state, get_goal_facts and set_goal,
+    so that they do not allocate once the buffers are large enough.
+    num_buffer_allocations counts the calls that had to grow a buffer.
+  */
+  State converted_state;
+  std::vector<int> goal_values;
+  std::vector<std::pair<int, int>> goal_facts;
+  long long num_conversions;
+  long long num_buffer_allocations;
+  long long num_unchanged_goals;
+
+  void count_buffer_growth(std::size_t old_capacity, std::size_t new_capacity);
+
+ protected:
+
   enum { DEAD_END = -1, NO_VALUE = -2 };
 
   virtual int compute_heuristic(const GlobalState &state) = 0;
 
+  /*
+    Batched versions of compute_heuristic that append one value (or
+    DEAD_END) per goal or per source to values. The default
+    implementations call set_goal and compute_result for each pair and
+    thus leave the goal of the last pair set. Heuristics that can share
+    work across a batch should override them without changing the goal.
+  */
+  virtual void compute_heuristic_batch(const GlobalState &source,
+                                       const std::vector<GlobalState> &goals,
+                                       std::vector<int> &values);
+  virtual void compute_heuristic_batch(const std::vector<GlobalState> &sources,
+                                       const GlobalState &goal,
+                                       std::vector<int> &values);
+
   void set_preferred(const OperatorProxy &op);
 
-  State convert_global_state(const GlobalState &global_state) const;
+  /*
+    Return global_state as a state of the task of the heuristic. The
+    values are read from packed storage into a buffer of the heuristic,
+    so the state is only valid until the next call.
+  */
+  const State &convert_global_state(const GlobalState &global_state);
+
+  /*
+    The facts that set_goal uses as the goal for global_state. Like the
+    result of convert_global_state, they are only valid until the next
+    call.
+  */
+  const std::vector<std::pair<int, int>> &get_goal_facts(
+      const GlobalState &global_state);
+
+  /*
+    Set current_goal to the goal facts of global_state and return true,
+    or return false without any work if global_state is already the
+    goal. Overrides of set_goal use it to skip updating their own goal
+    data for unchanged goals.
+  */
+  bool update_goal(const GlobalState &global_state);
+
+  /*
+    Copies everything except preferred operators, thread clones, workers,
+    memoized values and statistics.
+  */
+  FrontToFrontHeuristic(const FrontToFrontHeuristic &other);
 
  public:
   FrontToFrontHeuristic();
@@ -42,13 +127,64 @@ class FrontToFrontHeuristic : public Evaluator {
 
   virtual void set_goal(const GlobalState &state);
 
+  /*
+    Return an independent copy that can evaluate states concurrently
+    with this heuristic. Heuristics must not share mutable data with
+    their clones.
+  */
+  virtual std::shared_ptr<FrontToFrontHeuristic> clone() const = 0;
+
   virtual void get_path_dependent_evaluators(
       std::set<Evaluator *> & /*evals*/) override {}
 
+  /*
+    Insert this heuristic and all heuristics that it evaluates into
+    heuristics, e.g., to find heuristics that two open lists share.
+  */
+  virtual void get_involved_heuristics(
+      std::set<FrontToFrontHeuristic *> &heuristics) {
+    heuristics.insert(this);
+  }
+
   static void add_options_to_parser(options::OptionParser &parser);
 
+  /*
+    With a pair memo, values are looked up by the source state and the
+    state last passed to set_goal. Contexts that calculate preferred
+    operators are always evaluated since the memo has no operators.
+  */
   virtual EvaluationResult compute_result(
       EvaluationContext &eval_context) override;
+
+  virtual void print_statistics() const;
+
+  /*
+    Evaluate source against each of goals, or each of sources against
+    goal, as if calling set_goal and compute_result for each pair, and
+    return the values in order (EvaluationResult::INFTY for dead ends).
+    No preferred operators are computed.
+  */
+  std::vector<int> evaluate_batch(const GlobalState &source,
+                                  const std::vector<GlobalState> &goals);
+  std::vector<int> evaluate_batch(const std::vector<GlobalState> &sources,
+                                  const GlobalState &goal);
+
+  /*
+    Store the results of evaluate_batch for this evaluator in caches[i]
+    for the i-th pair, so that evaluation contexts created from the
+    caches do not evaluate again. Evaluators combining other evaluators
+    store the results of their components instead. With num_threads > 1,
+    the batch is split into chunks that are evaluated concurrently by
+    clones of this heuristic; the results do not depend on num_threads.
+  */
+  virtual void cache_batch(const GlobalState &source,
+                           const std::vector<GlobalState> &goals,
+                           std::vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics, int num_threads);
+  virtual void cache_batch(const std::vector<GlobalState> &sources,
+                           const GlobalState &goal,
+                           std::vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics, int num_threads);
 };
 
 #endif
\ No newline at end of file
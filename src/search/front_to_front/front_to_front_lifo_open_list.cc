@@ -38,11 +38,24 @@ class FrontToFrontLIFOOpenList : public FrontToFrontOpenList<Entry> {
   virtual bool empty() const override;
   virtual void clear() override;
   virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+  virtual void get_involved_heuristics(
+      set<FrontToFrontHeuristic *> &heuristics) override;
   virtual bool is_dead_end(EvaluationContext &eval_context) const override;
   virtual bool is_reliable_dead_end(
       EvaluationContext &eval_context) const override;
   virtual pair<int, Entry> get_min_value_and_entry() override;
   virtual void set_goal(const GlobalState &global_state) override;
+  virtual void print_statistics() const override;
+  virtual void cache_batch(const GlobalState &source,
+                           const vector<GlobalState> &goals,
+                           vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics,
+                           int num_threads) override;
+  virtual void cache_batch(const vector<GlobalState> &sources,
+                           const GlobalState &goal,
+                           vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics,
+                           int num_threads) override;
 };
 
 template <class Entry>
@@ -97,6 +110,12 @@ void FrontToFrontLIFOOpenList<Entry>::get_path_dependent_evaluators(
   evaluator->get_path_dependent_evaluators(evals);
 }
 
+template <class Entry>
+void FrontToFrontLIFOOpenList<Entry>::get_involved_heuristics(
+    set<FrontToFrontHeuristic *> &heuristics) {
+  evaluator->get_involved_heuristics(heuristics);
+}
+
 template <class Entry>
 bool FrontToFrontLIFOOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
@@ -127,6 +146,27 @@ void FrontToFrontLIFOOpenList<Entry>::set_goal(
   evaluator->set_goal(global_state);
 }
 
+template <class Entry>
+void FrontToFrontLIFOOpenList<Entry>::print_statistics() const {
+  evaluator->print_statistics();
+}
+
+template <class Entry>
+void FrontToFrontLIFOOpenList<Entry>::cache_batch(
+    const GlobalState &source, const vector<GlobalState> &goals,
+    vector<EvaluatorCache> &caches, SearchStatistics *statistics,
+    int num_threads) {
+  evaluator->cache_batch(source, goals, caches, statistics, num_threads);
+}
+
+template <class Entry>
+void FrontToFrontLIFOOpenList<Entry>::cache_batch(
+    const vector<GlobalState> &sources, const GlobalState &goal,
+    vector<EvaluatorCache> &caches, SearchStatistics *statistics,
+    int num_threads) {
+  evaluator->cache_batch(sources, goal, caches, statistics, num_threads);
+}
+
 FrontToFrontLIFOOpenListFactory::FrontToFrontLIFOOpenListFactory(
     const Options &options)
     : options(options) {}
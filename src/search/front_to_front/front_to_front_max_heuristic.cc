@@ -28,10 +28,22 @@ FrontToFrontHSPMaxHeuristic::FrontToFrontHSPMaxHeuristic(const Options &opts)
       cache_initial(opts.get<bool>("cache_initial")),
       fall_back_to(FallBackTo(opts.get_enum("fall_back_to"))) {
   cout << "Initializing HSP max heuristic..." << endl;
+  if (unit_cost) cout << "Using unit-cost exploration for h^max" << endl;
 
   if (cache_initial) precompute_exploration(task_proxy.get_initial_state());
 }
 
+FrontToFrontHSPMaxHeuristic::FrontToFrontHSPMaxHeuristic(
+    const FrontToFrontHSPMaxHeuristic &other)
+    : FrontToFrontRelaxationHeuristic(other),
+      cache_initial(other.cache_initial),
+      fall_back_to(other.fall_back_to) {}
+
+shared_ptr<FrontToFrontHeuristic> FrontToFrontHSPMaxHeuristic::clone() const {
+  return shared_ptr<FrontToFrontHSPMaxHeuristic>(
+      new FrontToFrontHSPMaxHeuristic(*this));
+}
+
 // heuristic computation
 void FrontToFrontHSPMaxHeuristic::setup_exploration_queue() {
   queue.clear();
@@ -56,8 +68,8 @@ void FrontToFrontHSPMaxHeuristic::setup_exploration_queue_state(
   }
 }
 
-void FrontToFrontHSPMaxHeuristic::relaxed_exploration() {
-  int unsolved_goals = goal_propositions.size();
+void FrontToFrontHSPMaxHeuristic::relaxed_exploration(bool complete) {
+  int unsolved_goals = complete ? -1 : goal_propositions.size();
   while (!queue.empty()) {
     pair<int, PropID> top_pair = queue.pop();
     int distance = top_pair.first;
@@ -80,42 +92,121 @@ void FrontToFrontHSPMaxHeuristic::relaxed_exploration() {
   }
 }
 
-void FrontToFrontHSPMaxHeuristic::precompute_exploration(const State &state) {
-  setup_exploration_queue();
-  setup_exploration_queue_state(state);
+void FrontToFrontHSPMaxHeuristic::unit_cost_exploration(const State &state,
+                                                        bool complete) {
+  layer_queue.clear();
 
-  while (!queue.empty()) {
-    pair<int, PropID> top_pair = queue.pop();
-    int distance = top_pair.first;
-    PropID prop_id = top_pair.second;
+  for (Proposition &prop : propositions) prop.cost = -1;
+
+  for (FactProxy fact : state) {
+    PropID init_prop = get_prop_id(fact);
+    Proposition *prop = get_proposition(init_prop);
+    if (prop->cost == -1) {
+      prop->cost = 0;
+      layer_queue.push_back(init_prop);
+    }
+  }
+
+  for (UnaryOperator &op : unary_operators) {
+    op.unsatisfied_preconditions = op.num_preconditions;
+    if (op.unsatisfied_preconditions == 0) {
+      Proposition *effect = get_proposition(op.effect);
+      if (effect->cost == -1) {
+        effect->cost = 1;
+        layer_queue.push_back(op.effect);
+      }
+    }
+  }
+
+  /*
+    The queue is ordered by cost, so the precondition that makes an
+    operator applicable is its most expensive one, and the first
+    operator reaching a proposition reaches it with minimum cost.
+  */
+  int unsolved_goals = complete ? -1 : goal_propositions.size();
+  for (size_t next = 0; next < layer_queue.size(); ++next) {
+    PropID prop_id = layer_queue[next];
     Proposition *prop = get_proposition(prop_id);
-    int prop_cost = prop->cost;
-    assert(prop_cost >= 0);
-    assert(prop_cost <= distance);
-    if (prop_cost < distance) continue;
+    if (prop->is_goal && --unsolved_goals == 0) return;
+    int effect_cost = prop->cost + 1;
     for (OpID op_id : precondition_of_pool.get_slice(
              prop->precondition_of, prop->num_precondition_occurences)) {
       UnaryOperator *unary_op = get_operator(op_id);
-      unary_op->cost = max(unary_op->cost, unary_op->base_cost + prop_cost);
-      --unary_op->unsatisfied_preconditions;
-      assert(unary_op->unsatisfied_preconditions >= 0);
-      if (unary_op->unsatisfied_preconditions == 0)
-        enqueue_if_necessary(unary_op->effect, unary_op->cost);
+      if (--unary_op->unsatisfied_preconditions == 0) {
+        Proposition *effect = get_proposition(unary_op->effect);
+        if (effect->cost == -1) {
+          effect->cost = effect_cost;
+          layer_queue.push_back(unary_op->effect);
+        }
+      }
     }
   }
 }
 
+#ifndef NDEBUG
+void FrontToFrontHSPMaxHeuristic::verify_unit_cost_exploration(
+    const State &state, bool complete) {
+  vector<int> unit_costs;
+  unit_costs.reserve(propositions.size());
+  for (const Proposition &prop : propositions) unit_costs.push_back(prop.cost);
+
+  setup_exploration_queue();
+  setup_exploration_queue_state(state);
+  relaxed_exploration(complete);
+
+  for (size_t i = 0; i < propositions.size(); ++i) {
+    Proposition &prop = propositions[i];
+    assert(!(complete || prop.is_goal) || prop.cost == unit_costs[i]);
+    // Incomplete explorations may differ on other propositions.
+    prop.cost = unit_costs[i];
+  }
+}
+#endif
+
+void FrontToFrontHSPMaxHeuristic::precompute_exploration(const State &state) {
+  if (unit_cost) {
+    unit_cost_exploration(state, true);
+#ifndef NDEBUG
+    verify_unit_cost_exploration(state, true);
+#endif
+    return;
+  }
+
+  setup_exploration_queue();
+  setup_exploration_queue_state(state);
+  relaxed_exploration(true);
+}
+
+void FrontToFrontHSPMaxHeuristic::explore_from(const State &state) {
+  if (cache_initial || load_cached_exploration(state)) return;
+
+  precompute_exploration(state);
+  cache_exploration(state);
+}
+
 int FrontToFrontHSPMaxHeuristic::compute_heuristic(
     const GlobalState &global_state) {
   if (cache_initial) {
     for (Proposition &prop : propositions) prop.marked = false;
+  } else if (exploration_cache_size > 0) {
+    explore_from(convert_global_state(global_state));
+  } else if (unit_cost) {
+    const State &state = convert_global_state(global_state);
+    unit_cost_exploration(state, false);
+#ifndef NDEBUG
+    verify_unit_cost_exploration(state, false);
+#endif
   } else {
-    const State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     setup_exploration_queue();
     setup_exploration_queue_state(state);
-    relaxed_exploration();
+    relaxed_exploration(false);
   }
 
+  return compute_goal_cost();
+}
+
+int FrontToFrontHSPMaxHeuristic::compute_goal_cost() {
   int total_cost = 0;
   for (PropID goal_id : goal_propositions) {
     const Proposition *goal = get_proposition(goal_id);
@@ -140,6 +231,11 @@ static shared_ptr<FrontToFrontHeuristic> _parse(OptionParser &parser) {
   parser.document_property("safe", "yes for tasks without axioms");
   parser.document_property("preferred operators", "no");
   parser.add_option<bool>("cache_initial", "fix initial state", "false");
+  parser.add_option<int>(
+      "exploration_cache_size",
+      "number of source states whose relaxed exploration is kept and "
+      "reused for different goals (0 to disable)",
+      "0", Bounds("0", "infinity"));
 
   vector<string> fall_back_to;
   vector<string> fall_back_to_doc;
@@ -6,6 +6,7 @@
 #include "../algorithms/priority_queues.h"
 
 #include <cassert>
+#include <vector>
 
 namespace front_to_front_max_heuristic {
 using front_to_front_relaxation_heuristic::OpID;
@@ -17,10 +18,16 @@ using front_to_front_relaxation_heuristic::UnaryOperator;
 class FrontToFrontHSPMaxHeuristic : public front_to_front_relaxation_heuristic::
                                         FrontToFrontRelaxationHeuristic {
   priority_queues::AdaptiveQueue<PropID> queue;
+  /*
+    FIFO queue of the unit-cost exploration. Propositions are reached in
+    order of their cost, so each one is queued at most once.
+  */
+  std::vector<PropID> layer_queue;
 
   void setup_exploration_queue();
   void setup_exploration_queue_state(const State &state);
-  void relaxed_exploration();
+  // Stops when all goals are reached unless complete is true.
+  void relaxed_exploration(bool complete);
 
   void enqueue_if_necessary(PropID prop_id, int cost) {
     assert(cost >= 0);
@@ -33,6 +40,20 @@ class FrontToFrontHSPMaxHeuristic : public front_to_front_relaxation_heuristic::
   }
 
   void precompute_exploration(const State &state);
+  /*
+    Breadth-first exploration for unit-cost tasks. It computes the same
+    costs as the generic exploration without a priority queue and stops
+    when all goals are reached unless complete is true.
+  */
+  void unit_cost_exploration(const State &state, bool complete);
+#ifndef NDEBUG
+  /*
+    Debug builds check each unit-cost exploration against the generic
+    one: the costs of all propositions must match after a complete
+    exploration, and the costs of the goals otherwise.
+  */
+  void verify_unit_cost_exploration(const State &state, bool complete);
+#endif
 
  public:
   enum FallBackTo { NONE = 0, INITIAL = 1, GOAL = 2 };
@@ -43,8 +64,16 @@ class FrontToFrontHSPMaxHeuristic : public front_to_front_relaxation_heuristic::
 
   virtual int compute_heuristic(const GlobalState &global_state) override;
 
+  virtual void explore_from(const State &state) override;
+  virtual int compute_goal_cost() override;
+
+  // The exploration queue is not copied; it is empty between explorations.
+  FrontToFrontHSPMaxHeuristic(const FrontToFrontHSPMaxHeuristic &other);
+
  public:
   explicit FrontToFrontHSPMaxHeuristic(const options::Options &opts);
+
+  virtual std::shared_ptr<FrontToFrontHeuristic> clone() const override;
 };
 }  // namespace front_to_front_max_heuristic
 
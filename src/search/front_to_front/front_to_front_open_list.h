@@ -1,13 +1,18 @@
 #ifndef FRONT_TO_FRONT_OPEN_LIST_H
 #define FRONT_TO_FRONT_OPEN_LIST_H
 
+#include <functional>
 #include <iostream>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "../evaluation_context.h"
+#include "../evaluator_cache.h"
 #include "../operator_id.h"
 
+class FrontToFrontHeuristic;
+class SearchStatistics;
 class StateID;
 
 template <class Entry>
@@ -15,6 +20,9 @@ class FrontToFrontOpenList {
   bool only_preferred;
 
  protected:
+  // Entries for which is_stale holds are not worth expanding any more.
+  std::function<bool(const Entry &)> is_stale;
+
   virtual void do_insertion(EvaluationContext &eval_context, const Entry &entry,
                             bool to_top) = 0;
 
@@ -29,12 +37,45 @@ class FrontToFrontOpenList {
   virtual void clear() = 0;
   virtual void boost_preferred();
   virtual void get_path_dependent_evaluators(std::set<Evaluator *> &evals) = 0;
+  // See FrontToFrontHeuristic::get_involved_heuristics.
+  virtual void get_involved_heuristics(
+      std::set<FrontToFrontHeuristic *> &heuristics) = 0;
   bool only_contains_preferred_entries() const;
   virtual bool is_dead_end(EvaluationContext &eval_context) const = 0;
   virtual bool is_reliable_dead_end(EvaluationContext &eval_context) const = 0;
 
   virtual std::pair<int, Entry> get_min_value_and_entry() = 0;
+
+  /*
+    Closed states stay in open lists until they are removed, so the
+    minimum entry may be stale. prune_stale_min removes stale entries
+    from the top, as decided by the filter set with set_stale_filter,
+    and returns whether an entry is left. Afterwards,
+    get_min_value_and_entry returns a live entry.
+  */
+  virtual void set_stale_filter(
+      const std::function<bool(const Entry &)> &filter);
+  virtual bool prune_stale_min();
   virtual void set_goal(const GlobalState &global_state) = 0;
+  // Print the statistics of the heuristics of this open list.
+  virtual void print_statistics() const = 0;
+
+  /*
+    Evaluate the heuristics of this open list for source against each of
+    goals, or for each of sources against goal, in one batch (see
+    FrontToFrontHeuristic::evaluate_batch) and store the results in
+    caches. Contexts created from caches[i] can be inserted without
+    calling set_goal first. Heuristics that batch natively keep the goal
+    set by set_goal.
+  */
+  virtual void cache_batch(const GlobalState &source,
+                           const std::vector<GlobalState> &goals,
+                           std::vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics, int num_threads) = 0;
+  virtual void cache_batch(const std::vector<GlobalState> &sources,
+                           const GlobalState &goal,
+                           std::vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics, int num_threads) = 0;
 };
 
 using StateOpenListEntry = StateID;
@@ -57,6 +98,21 @@ FrontToFrontOpenList<Entry>::FrontToFrontOpenList(bool only_preferred)
 template <class Entry>
 void FrontToFrontOpenList<Entry>::boost_preferred() {}
 
+template <class Entry>
+void FrontToFrontOpenList<Entry>::set_stale_filter(
+    const std::function<bool(const Entry &)> &filter) {
+  is_stale = filter;
+}
+
+template <class Entry>
+bool FrontToFrontOpenList<Entry>::prune_stale_min() {
+  while (!empty()) {
+    if (!is_stale || !is_stale(get_min_value_and_entry().second)) return true;
+    remove_min();
+  }
+  return false;
+}
+
 template <class Entry>
 void FrontToFrontOpenList<Entry>::insert(EvaluationContext &eval_context,
                                          const Entry &entry, bool to_top) {
@@ -0,0 +1,55 @@
+#include "front_to_front_pair_memo.h"
+
+#include "../utils/hash.h"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+
+using namespace std;
+
+namespace front_to_front_pair_memo {
+PairMemo::PairMemo(size_t capacity)
+    : capacity(capacity), num_hits(0), num_misses(0), num_evictions(0) {}
+
+PairMemo::Entry &PairMemo::get_entry(StateID source, StateID goal) {
+  assert(is_enabled());
+  if (entries.empty()) entries.resize(capacity);
+  uint64_t hash =
+      utils::get_hash64(make_pair(source.get_value(), goal.get_value()));
+  return entries[hash % capacity];
+}
+
+bool PairMemo::lookup(StateID source, StateID goal, int &value) {
+  assert(source != StateID::no_state);
+  Entry &entry = get_entry(source, goal);
+  if (entry.source == source.get_value() && entry.goal == goal.get_value()) {
+    ++num_hits;
+    value = entry.value;
+    return true;
+  }
+  ++num_misses;
+  return false;
+}
+
+void PairMemo::store(StateID source, StateID goal, int value) {
+  assert(source != StateID::no_state);
+  Entry &entry = get_entry(source, goal);
+  if (entry.source != -1 && (entry.source != source.get_value() ||
+                             entry.goal != goal.get_value()))
+    ++num_evictions;
+  entry.source = source.get_value();
+  entry.goal = goal.get_value();
+  entry.value = value;
+}
+
+void PairMemo::print_statistics() const {
+  if (!is_enabled()) return;
+  cout << "Pair memo hits: " << num_hits << endl;
+  cout << "Pair memo misses: " << num_misses << endl;
+  cout << "Pair memo evictions: " << num_evictions << endl;
+  cout << "Pair memo size: " << capacity << " entries ("
+       << capacity * sizeof(Entry) / 1024 << " KB)" << endl;
+}
+}  // namespace front_to_front_pair_memo
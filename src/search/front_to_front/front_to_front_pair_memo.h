@@ -0,0 +1,50 @@
+#ifndef FRONT_TO_FRONT_PAIR_MEMO_H
+#define FRONT_TO_FRONT_PAIR_MEMO_H
+
+#include "../state_id.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace front_to_front_pair_memo {
+/*
+  Memo of heuristic values keyed by (source, goal) state pairs. It is a
+  direct-mapped table with capacity slots: each pair has one slot, and
+  storing a pair evicts the pair in its slot, so the memo never uses
+  more than capacity entries. The table is allocated on first use, and
+  a capacity of 0 disables the memo.
+*/
+class PairMemo {
+  struct Entry {
+    // StateID values; source is -1 for empty slots.
+    int source;
+    int goal;
+    int value;
+
+    Entry() : source(-1), goal(-1), value(0) {}
+  };
+
+  std::size_t capacity;
+  std::vector<Entry> entries;
+
+  long long num_hits;
+  long long num_misses;
+  long long num_evictions;
+
+  Entry &get_entry(StateID source, StateID goal);
+
+ public:
+  explicit PairMemo(std::size_t capacity);
+
+  bool is_enabled() const { return capacity > 0; }
+  std::size_t get_capacity() const { return capacity; }
+
+  // Set value and return true if the pair is memoized.
+  bool lookup(StateID source, StateID goal, int &value);
+  void store(StateID source, StateID goal, int value);
+
+  void print_statistics() const;
+};
+}  // namespace front_to_front_pair_memo
+
+#endif
@@ -1,5 +1,7 @@
 #include "front_to_front_relaxation_heuristic.h"
 
+#include "../option_parser.h"
+
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
 #include "../utils/timer.h"
@@ -7,6 +9,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <iostream>
 #include <unordered_map>
 #include <vector>
 
@@ -32,7 +35,11 @@ UnaryOperator::UnaryOperator(int num_preconditions,
 // construction and destruction
 FrontToFrontRelaxationHeuristic::FrontToFrontRelaxationHeuristic(
     const options::Options &opts)
-    : FrontToFrontHeuristic(opts) {
+    : FrontToFrontHeuristic(opts),
+      goal_propositions_sorted(true),
+      num_goal_updates(0),
+      num_changed_goal_propositions(0),
+      exploration_cache_size(opts.get<int>("exploration_cache_size")) {
   // Build propositions.
   propositions.resize(task_properties::get_num_facts(task_proxy));
 
@@ -46,6 +53,8 @@ FrontToFrontRelaxationHeuristic::FrontToFrontRelaxationHeuristic(
   }
   assert(offset == static_cast<int>(propositions.size()));
 
+  for (FactProxy goal : task_proxy.get_goals())
+    original_goal.emplace_back(goal.get_variable().get_id(), goal.get_value());
   set_original_goal();
 
   // Build unary operators for operators and axioms.
@@ -59,6 +68,10 @@ FrontToFrontRelaxationHeuristic::FrontToFrontRelaxationHeuristic(
   simplify();
   cout << "time to simplify: " << simplify_timer << endl;
 
+  unit_cost = all_of(
+      unary_operators.begin(), unary_operators.end(),
+      [](const UnaryOperator &op) { return op.base_cost == 1; });
+
   // Cross-reference unary operators.
   vector<vector<OpID>> precondition_of_vectors(propositions.size());
 
@@ -283,38 +296,153 @@ void FrontToFrontRelaxationHeuristic::simplify() {
   cout << " done! [" << unary_operators.size() << " unary operators]" << endl;
 }
 
-void FrontToFrontRelaxationHeuristic::do_set_goal() {
-  for (PropID prop_id : goal_propositions)
-    propositions[prop_id].is_goal = false;
+void FrontToFrontRelaxationHeuristic::set_goal_propositions(
+    const vector<pair<int, int>> &goal) {
+  next_goal_propositions.clear();
+  for (auto fact : goal)
+    next_goal_propositions.push_back(get_prop_id(fact.first, fact.second));
+
+  bool next_sorted =
+      is_sorted(next_goal_propositions.begin(), next_goal_propositions.end());
+  ++num_goal_updates;
+
+  if (goal_propositions_sorted && next_sorted) {
+    auto old_it = goal_propositions.begin();
+    auto old_end = goal_propositions.end();
+    auto next_it = next_goal_propositions.begin();
+    auto next_end = next_goal_propositions.end();
+
+    while (old_it != old_end || next_it != next_end) {
+      if (next_it == next_end || (old_it != old_end && *old_it < *next_it)) {
+        propositions[*old_it++].is_goal = false;
+        ++num_changed_goal_propositions;
+      } else if (old_it == old_end || *next_it < *old_it) {
+        propositions[*next_it++].is_goal = true;
+        ++num_changed_goal_propositions;
+      } else {
+        ++old_it;
+        ++next_it;
+      }
+    }
+  } else {
+    for (PropID prop_id : goal_propositions)
+      propositions[prop_id].is_goal = false;
+    for (PropID prop_id : next_goal_propositions)
+      propositions[prop_id].is_goal = true;
+    num_changed_goal_propositions +=
+        goal_propositions.size() + next_goal_propositions.size();
+  }
 
-  goal_propositions.clear();
+  goal_propositions.swap(next_goal_propositions);
+  goal_propositions_sorted = next_sorted;
+}
 
-  for (auto goal : current_goal) {
-    PropID prop_id = get_prop_id(goal.first, goal.second);
-    propositions[prop_id].is_goal = true;
-    goal_propositions.push_back(prop_id);
-  }
+void FrontToFrontRelaxationHeuristic::do_set_goal() {
+  set_goal_propositions(current_goal);
 }
 
 void FrontToFrontRelaxationHeuristic::set_goal(const GlobalState &state) {
   if (cache_goal) return;
 
-  FrontToFrontHeuristic::set_goal(state);
-  do_set_goal();
+  if (update_goal(state)) do_set_goal();
 }
 
 void FrontToFrontRelaxationHeuristic::set_original_goal() {
-  for (PropID prop_id : goal_propositions)
-    propositions[prop_id].is_goal = false;
+  set_goal_propositions(original_goal);
+}
+
+void FrontToFrontRelaxationHeuristic::print_statistics() const {
+  FrontToFrontHeuristic::print_statistics();
+  cout << "Goal proposition updates: " << num_goal_updates << " ("
+       << num_changed_goal_propositions << " propositions changed)" << endl;
+}
+
+bool FrontToFrontRelaxationHeuristic::load_cached_exploration(
+    const State &state) {
+  const vector<int> &values = state.get_values();
+  auto it = find_if(exploration_cache.begin(), exploration_cache.end(),
+                    [&values](const CachedExploration &entry) {
+                      return entry.source_values == values;
+                    });
+
+  if (it == exploration_cache.end()) return false;
+  if (it == exploration_cache.begin()) return true;
 
-  goal_propositions.clear();
+  rotate(exploration_cache.begin(), it, next(it));
+  const CachedExploration &entry = exploration_cache.front();
 
-  GoalsProxy goals = task_proxy.get_goals();
-  for (FactProxy goal : goals) {
-    PropID prop_id = get_prop_id(goal);
-    propositions[prop_id].is_goal = true;
-    goal_propositions.push_back(prop_id);
+  for (size_t i = 0; i < propositions.size(); ++i) {
+    propositions[i].cost = entry.costs[i];
+    propositions[i].reached_by = entry.reached_by[i];
   }
+
+  return true;
 }
 
+void FrontToFrontRelaxationHeuristic::cache_exploration(const State &state) {
+  if (exploration_cache_size == 0) return;
+
+  if (static_cast<int>(exploration_cache.size()) < exploration_cache_size) {
+    exploration_cache.emplace_front();
+  } else {
+    // Reuse the buffers of the least recently used entry.
+    rotate(exploration_cache.begin(), prev(exploration_cache.end()),
+           exploration_cache.end());
+  }
+
+  CachedExploration &entry = exploration_cache.front();
+  entry.source_values = state.get_values();
+  entry.costs.resize(propositions.size());
+  entry.reached_by.resize(propositions.size());
+
+  for (size_t i = 0; i < propositions.size(); ++i) {
+    entry.costs[i] = propositions[i].cost;
+    entry.reached_by[i] = propositions[i].reached_by;
+  }
+}
+
+void FrontToFrontRelaxationHeuristic::compute_heuristic_batch(
+    const GlobalState &source, const vector<GlobalState> &goals,
+    vector<int> &values) {
+  size_t first = values.size();
+  explore_from(convert_global_state(source));
+
+  for (const GlobalState &goal : goals) {
+    if (!cache_goal) set_goal_propositions(get_goal_facts(goal));
+    values.push_back(compute_goal_cost());
+  }
+
+  /*
+    Falling back needs explorations from other sources, so we do it
+    after the batch for the dead ends only.
+  */
+  if (falls_back()) {
+    for (size_t i = 0; i < goals.size(); ++i) {
+      if (values[first + i] != DEAD_END) continue;
+      vector<pair<int, int>> goal =
+          cache_goal ? current_goal : get_goal_facts(goals[i]);
+      swap(current_goal, goal);
+      do_set_goal();
+      values[first + i] = compute_heuristic(source);
+      swap(current_goal, goal);
+    }
+  }
+
+  do_set_goal();
+}
+
+void FrontToFrontRelaxationHeuristic::compute_heuristic_batch(
+    const vector<GlobalState> &sources, const GlobalState &goal,
+    vector<int> &values) {
+  vector<pair<int, int>> goal_facts =
+      cache_goal ? current_goal : get_goal_facts(goal);
+  swap(current_goal, goal_facts);
+  do_set_goal();
+
+  for (const GlobalState &source : sources)
+    values.push_back(compute_heuristic(source));
+
+  swap(current_goal, goal_facts);
+  do_set_goal();
+}
 }  // namespace front_to_front_relaxation_heuristic
@@ -8,6 +8,8 @@
 #include "../utils/collections.h"
 
 #include <cassert>
+#include <deque>
+#include <utility>
 #include <vector>
 
 class FactProxy;
@@ -54,12 +56,35 @@ struct UnaryOperator {
 static_assert(sizeof(UnaryOperator) == 28, "UnaryOperator has wrong size");
 
 class FrontToFrontRelaxationHeuristic : public FrontToFrontHeuristic {
+  /*
+    Proposition costs of a complete relaxed exploration from a source
+    state. Since only the goal changes when many states are evaluated
+    against the same source (e.g., predecessors against one frontier
+    state), the exploration is reused for any goal.
+  */
+  struct CachedExploration {
+    std::vector<int> source_values;
+    std::vector<int> costs;
+    std::vector<OpID> reached_by;
+  };
+
   void build_unary_operators(const OperatorProxy &op);
   void simplify();
 
   // proposition_offsets[var_no]: first PropID related to variable var_no
   std::vector<PropID> proposition_offsets;
 
+  // Most recently used first. The front is the one in propositions.
+  std::deque<CachedExploration> exploration_cache;
+
+  std::vector<std::pair<int, int>> original_goal;
+  // Buffer for the next goal_propositions in set_goal_propositions.
+  std::vector<PropID> next_goal_propositions;
+  // True if goal_propositions is in increasing order.
+  bool goal_propositions_sorted;
+  long long num_goal_updates;
+  long long num_changed_goal_propositions;
+
  protected:
   std::vector<UnaryOperator> unary_operators;
   std::vector<Proposition> propositions;
@@ -108,8 +133,50 @@ class FrontToFrontRelaxationHeuristic : public FrontToFrontHeuristic {
   Proposition *get_proposition(int var, int value);
   Proposition *get_proposition(const FactProxy &fact);
 
+  /*
+    Make goal the goal propositions, keeping its order. Only propositions
+    that enter or leave the goal are touched if both the old and the new
+    goal are sorted by variable, as goals of partial states are.
+  */
+  void set_goal_propositions(const std::vector<std::pair<int, int>> &goal);
   void do_set_goal();
 
+  const int exploration_cache_size;
+
+  /*
+    True if every unary operator has cost 1, as with
+    adapt_costs(cost_type=ONE). Subclasses use it to select explorations
+    specialized for unit costs.
+  */
+  bool unit_cost;
+
+  /*
+    Restore the proposition costs of a cached exploration from state and
+    return true, or return false if there is none. cache_exploration
+    stores the current proposition costs, which must be the result of a
+    complete (not goal-terminated) exploration from state.
+  */
+  bool load_cached_exploration(const State &state);
+  void cache_exploration(const State &state);
+
+  /*
+    explore_from runs a complete relaxed exploration from state (or
+    restores a cached one), after which compute_goal_cost evaluates any
+    goal_propositions without exploring again. compute_goal_cost does
+    not fall back to other sources or goals on dead ends; heuristics
+    that do return true in falls_back.
+  */
+  virtual void explore_from(const State &state) = 0;
+  virtual int compute_goal_cost() = 0;
+  virtual bool falls_back() const { return false; }
+
+  virtual void compute_heuristic_batch(const GlobalState &source,
+                                       const std::vector<GlobalState> &goals,
+                                       std::vector<int> &values) override;
+  virtual void compute_heuristic_batch(const std::vector<GlobalState> &sources,
+                                       const GlobalState &goal,
+                                       std::vector<int> &values) override;
+
  public:
   explicit FrontToFrontRelaxationHeuristic(const options::Options &options);
 
@@ -118,6 +185,8 @@ class FrontToFrontRelaxationHeuristic : public FrontToFrontHeuristic {
   virtual void set_goal(const GlobalState &state) override;
 
   virtual void set_original_goal();
+
+  virtual void print_statistics() const override;
 };
 }  // namespace front_to_front_relaxation_heuristic
 
@@ -19,6 +19,10 @@ FrontToFrontSumEvaluator::FrontToFrontSumEvaluator(
 
 FrontToFrontSumEvaluator::~FrontToFrontSumEvaluator() {}
 
+shared_ptr<FrontToFrontHeuristic> FrontToFrontSumEvaluator::clone() const {
+  return make_shared<FrontToFrontSumEvaluator>(clone_subevaluators());
+}
+
 int FrontToFrontSumEvaluator::combine_values(const vector<int> &values) {
   int result = 0;
   for (int value : values) {
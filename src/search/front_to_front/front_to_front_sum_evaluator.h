@@ -21,6 +21,8 @@ class FrontToFrontSumEvaluator : public front_to_front_combining_evaluator::
   explicit FrontToFrontSumEvaluator(
       const std::vector<std::shared_ptr<FrontToFrontHeuristic>> &evals);
   virtual ~FrontToFrontSumEvaluator() override;
+
+  virtual std::shared_ptr<FrontToFrontHeuristic> clone() const override;
 };
 }  // namespace front_to_front_sum_evaluator
 
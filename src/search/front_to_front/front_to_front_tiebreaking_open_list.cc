@@ -4,11 +4,12 @@
 #include "../plugin.h"
 #include "front_to_front_heuristic.h"
 #include "front_to_front_open_list.h"
+#include "open_list_bucket.h"
 
 #include "../utils/memory.h"
 
+#include <array>
 #include <cassert>
-#include <deque>
 #include <map>
 #include <utility>
 #include <vector>
@@ -18,10 +19,30 @@ using namespace std;
 namespace front_to_front_tiebreaking_open_list {
 template <class Entry>
 class FrontToFrontTieBreakingOpenList : public FrontToFrontOpenList<Entry> {
-  using Bucket = deque<Entry>;
+  using Bucket = open_list_bucket::Bucket<Entry>;
 
-  map<const vector<int>, Bucket> buckets;
+  static const int MAX_INLINE_VALUES = 4;
+
+  /*
+    The evaluator values of an entry, compared lexicographically. The
+    first MAX_INLINE_VALUES values are stored inline, so the keys of up
+    to that many evaluators allocate no memory. Further values go to
+    overflow. Unused inline values are 0 in all keys.
+  */
+  struct Key {
+    array<int, MAX_INLINE_VALUES> values;
+    vector<int> overflow;
+
+    bool operator<(const Key &other) const {
+      if (values != other.values) return values < other.values;
+      return overflow < other.overflow;
+    }
+  };
+
+  map<Key, Bucket> buckets;
   int size;
+  // Reused for the key of each insertion.
+  Key key;
 
   vector<shared_ptr<FrontToFrontHeuristic>> evaluators;
   /*
@@ -45,11 +66,24 @@ class FrontToFrontTieBreakingOpenList : public FrontToFrontOpenList<Entry> {
   virtual bool empty() const override;
   virtual void clear() override;
   virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+  virtual void get_involved_heuristics(
+      set<FrontToFrontHeuristic *> &heuristics) override;
   virtual bool is_dead_end(EvaluationContext &eval_context) const override;
   virtual bool is_reliable_dead_end(
       EvaluationContext &eval_context) const override;
   virtual pair<int, Entry> get_min_value_and_entry() override;
   virtual void set_goal(const GlobalState &global_state) override;
+  virtual void print_statistics() const override;
+  virtual void cache_batch(const GlobalState &source,
+                           const vector<GlobalState> &goals,
+                           vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics,
+                           int num_threads) override;
+  virtual void cache_batch(const vector<GlobalState> &sources,
+                           const GlobalState &goal,
+                           vector<EvaluatorCache> &caches,
+                           SearchStatistics *statistics,
+                           int num_threads) override;
 };
 
 template <class Entry>
@@ -58,28 +92,38 @@ FrontToFrontTieBreakingOpenList<Entry>::FrontToFrontTieBreakingOpenList(
     : FrontToFrontOpenList<Entry>(opts.get<bool>("pref_only")),
       size(0),
       evaluators(opts.get_list<shared_ptr<FrontToFrontHeuristic>>("evals")),
-      allow_unsafe_pruning(opts.get<bool>("unsafe_pruning")) {}
+      allow_unsafe_pruning(opts.get<bool>("unsafe_pruning")) {
+  key.values.fill(0);
+  if (dimension() > MAX_INLINE_VALUES)
+    key.overflow.resize(dimension() - MAX_INLINE_VALUES);
+}
 
 template <class Entry>
 void FrontToFrontTieBreakingOpenList<Entry>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry, bool to_top) {
-  vector<int> key;
-  key.reserve(evaluators.size());
-  for (const shared_ptr<Evaluator> &evaluator : evaluators)
-    key.push_back(
-        eval_context.get_evaluator_value_or_infinity(evaluator.get()));
+  for (int i = 0; i < dimension(); ++i) {
+    int value =
+        eval_context.get_evaluator_value_or_infinity(evaluators[i].get());
+    if (i < MAX_INLINE_VALUES)
+      key.values[i] = value;
+    else
+      key.overflow[i - MAX_INLINE_VALUES] = value;
+  }
+
+  auto it = buckets.find(key);
+  if (it == buckets.end()) it = buckets.emplace(key, Bucket()).first;
 
   if (to_top)
-    buckets[key].push_front(entry);
+    it->second.push_front(entry);
   else
-    buckets[key].push_back(entry);
+    it->second.push_back(entry);
   ++size;
 }
 
 template <class Entry>
 Entry FrontToFrontTieBreakingOpenList<Entry>::remove_min() {
   assert(size > 0);
-  typename map<const vector<int>, Bucket>::iterator it;
+  typename map<Key, Bucket>::iterator it;
   it = buckets.begin();
   assert(it != buckets.end());
   assert(!it->second.empty());
@@ -109,10 +153,17 @@ int FrontToFrontTieBreakingOpenList<Entry>::dimension() const {
 template <class Entry>
 void FrontToFrontTieBreakingOpenList<Entry>::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
-  for (const shared_ptr<Evaluator> &evaluator : evaluators)
+  for (const shared_ptr<FrontToFrontHeuristic> &evaluator : evaluators)
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+template <class Entry>
+void FrontToFrontTieBreakingOpenList<Entry>::get_involved_heuristics(
+    set<FrontToFrontHeuristic *> &heuristics) {
+  for (const shared_ptr<FrontToFrontHeuristic> &evaluator : evaluators)
+    evaluator->get_involved_heuristics(heuristics);
+}
+
 template <class Entry>
 bool FrontToFrontTieBreakingOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
@@ -125,7 +176,7 @@ bool FrontToFrontTieBreakingOpenList<Entry>::is_dead_end(
       eval_context.is_evaluator_value_infinite(evaluators[0].get()))
     return true;
   // Otherwise, return true if all heuristics agree this is a dead-end.
-  for (const shared_ptr<Evaluator> &evaluator : evaluators)
+  for (const shared_ptr<FrontToFrontHeuristic> &evaluator : evaluators)
     if (!eval_context.is_evaluator_value_infinite(evaluator.get()))
       return false;
   return true;
@@ -134,7 +185,7 @@ bool FrontToFrontTieBreakingOpenList<Entry>::is_dead_end(
 template <class Entry>
 bool FrontToFrontTieBreakingOpenList<Entry>::is_reliable_dead_end(
     EvaluationContext &eval_context) const {
-  for (const shared_ptr<Evaluator> &evaluator : evaluators)
+  for (const shared_ptr<FrontToFrontHeuristic> &evaluator : evaluators)
     if (eval_context.is_evaluator_value_infinite(evaluator.get()) &&
         evaluator->dead_ends_are_reliable())
       return true;
@@ -151,7 +202,7 @@ FrontToFrontTieBreakingOpenList<Entry>::get_min_value_and_entry() {
   assert(!bucket.empty());
   Entry result = bucket.front();
 
-  return make_pair(it->first[0], result);
+  return make_pair(it->first.values[0], result);
 }
 
 template <class Entry>
@@ -161,6 +212,30 @@ void FrontToFrontTieBreakingOpenList<Entry>::set_goal(
     evaluator->set_goal(global_state);
 }
 
+template <class Entry>
+void FrontToFrontTieBreakingOpenList<Entry>::print_statistics() const {
+  for (const shared_ptr<FrontToFrontHeuristic> &evaluator : evaluators)
+    evaluator->print_statistics();
+}
+
+template <class Entry>
+void FrontToFrontTieBreakingOpenList<Entry>::cache_batch(
+    const GlobalState &source, const vector<GlobalState> &goals,
+    vector<EvaluatorCache> &caches, SearchStatistics *statistics,
+    int num_threads) {
+  for (const shared_ptr<FrontToFrontHeuristic> &evaluator : evaluators)
+    evaluator->cache_batch(source, goals, caches, statistics, num_threads);
+}
+
+template <class Entry>
+void FrontToFrontTieBreakingOpenList<Entry>::cache_batch(
+    const vector<GlobalState> &sources, const GlobalState &goal,
+    vector<EvaluatorCache> &caches, SearchStatistics *statistics,
+    int num_threads) {
+  for (const shared_ptr<FrontToFrontHeuristic> &evaluator : evaluators)
+    evaluator->cache_batch(sources, goal, caches, statistics, num_threads);
+}
+
 FrontToFrontTieBreakingOpenListFactory::FrontToFrontTieBreakingOpenListFactory(
     const Options &options)
     : options(options) {}
@@ -0,0 +1,45 @@
+#ifndef FRONT_TO_FRONT_OPEN_LIST_BUCKET_H_
+#define FRONT_TO_FRONT_OPEN_LIST_BUCKET_H_
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace open_list_bucket {
+/*
+  A FIFO queue of open list entries. Unlike a deque, an empty bucket
+  allocates no memory. Removed entries stay in front of head until they
+  make up half of the bucket, so removal is amortized constant time.
+*/
+template <class Entry>
+class Bucket {
+  std::vector<Entry> entries;
+  std::size_t head = 0;
+
+ public:
+  bool empty() const { return head == entries.size(); }
+  const Entry &front() const { return entries[head]; }
+  void push_back(const Entry &entry) { entries.push_back(entry); }
+
+  void push_front(const Entry &entry) {
+    if (head > 0)
+      entries[--head] = entry;
+    else
+      entries.insert(entries.begin(), entry);
+  }
+
+  void pop_front() {
+    assert(!empty());
+    ++head;
+    if (empty()) {
+      std::vector<Entry>().swap(entries);
+      head = 0;
+    } else if (2 * head >= entries.size()) {
+      entries.erase(entries.begin(), entries.begin() + head);
+      head = 0;
+    }
+  }
+};
+}  // namespace open_list_bucket
+
+#endif  // FRONT_TO_FRONT_OPEN_LIST_BUCKET_H_
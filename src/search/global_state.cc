@@ -35,6 +35,15 @@ State GlobalState::unpack() const {
     return task_proxy.create_state(move(values));
 }
 
+void GlobalState::unpack_into(
+    const TaskProxy &task_proxy, vector<int> &values) const {
+    int num_variables = registry->get_num_variables();
+    values.resize(num_variables);
+    for (int var = 0; var < num_variables; ++var)
+        values[var] = (*this)[var];
+    task_proxy.convert_ancestor_state_values(values, registry->get_task_proxy());
+}
+
 void GlobalState::dump_pddl() const {
     State state = unpack();
     task_properties::dump_pddl(state);
@@ -5,8 +5,16 @@
 
 #include "algorithms/int_packer.h"
 
+#include <vector>
+
+class FrontToFrontHeuristic;
 class State;
 class StateRegistry;
+class TaskProxy;
+
+namespace regression_successor_generator {
+class FlatGenerator;
+}
 
 using PackedStateBin = int_packer::IntPacker::Bin;
 
@@ -19,6 +27,8 @@ class GlobalState {
     template<typename>
     friend class PerStateArray;
     friend class PerStateBitset;
+    friend class regression_successor_generator::FlatGenerator;
+    friend class FrontToFrontHeuristic;
 
     // Values for vars are maintained in a packed state and accessed on demand.
     const PackedStateBin *buffer;
@@ -49,6 +59,15 @@ public:
 
     State unpack() const;
 
+    /*
+      Write the values of this state, converted to the task of task_proxy
+      (which must descend from the task of this state), into values.
+      Unlike task_proxy.convert_ancestor_state(unpack()), this reuses the
+      memory of values and does not allocate once values has enough
+      capacity.
+    */
+    void unpack_into(const TaskProxy &task_proxy, std::vector<int> &values) const;
+
     void dump_pddl() const;
     void dump_fdr() const;
 };
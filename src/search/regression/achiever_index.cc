@@ -0,0 +1,171 @@
+#include "achiever_index.h"
+
+#include "../global_state.h"
+#include "../tasks/root_task.h"
+#include "../utils/timer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace achiever_index {
+
+AchieverIndex::AchieverIndex(shared_ptr<const tasks::RegressionTask> task,
+                             const vector<OperatorID> &generator_order)
+    : num_visits(0) {
+  utils::Timer timer;
+  const AbstractTask &forward_task = *tasks::g_root_task;
+  int num_variables = task->get_num_variables();
+  int num_operators = task->get_num_operators();
+
+  unknown_values.reserve(num_variables);
+  var_offsets.reserve(num_variables);
+  int num_facts = 0;
+
+  for (int var = 0; var < num_variables; ++var) {
+    unknown_values.push_back(task->get_variable_domain_size(var) - 1);
+    var_offsets.push_back(num_facts);
+    num_facts += unknown_values.back();
+  }
+
+  effect_offsets.reserve(num_operators + 1);
+  effect_offsets.push_back(0);
+  vector<int> num_achievers(num_facts, 0);
+
+  for (int op = 0; op < num_operators; ++op) {
+    for (int i = 0; i < forward_task.get_num_operator_effects(op, false); ++i) {
+      FactPair fact = forward_task.get_operator_effect(op, i, false);
+      effects.push_back(fact);
+      ++num_achievers[var_offsets[fact.var] + fact.value];
+    }
+
+    effect_offsets.push_back(effects.size());
+  }
+
+  fact_offsets.reserve(num_facts + 1);
+  fact_offsets.push_back(0);
+
+  for (int n : num_achievers) fact_offsets.push_back(fact_offsets.back() + n);
+
+  // Fill the rows in the order of operators, so each row is sorted.
+  achievers.resize(fact_offsets.back(), OperatorID::no_operator);
+  vector<int> next(fact_offsets.begin(), fact_offsets.end() - 1);
+
+  for (int op = 0; op < num_operators; ++op) {
+    for (int i = effect_offsets[op]; i < effect_offsets[op + 1]; ++i) {
+      const FactPair &fact = effects[i];
+      achievers[next[var_offsets[fact.var] + fact.value]++] = OperatorID(op);
+    }
+  }
+
+  precondition_offsets.reserve(num_operators + 1);
+  precondition_offsets.push_back(0);
+
+  for (int op = 0; op < num_operators; ++op) {
+    int num_preconditions = task->get_num_operator_preconditions(op, false);
+
+    for (int i = 0; i < num_preconditions; ++i) {
+      FactPair fact = task->get_operator_precondition(op, i, false);
+      preconditions.push_back({fact.var, fact.value,
+                               task->is_negative_precondition(op, i, false)});
+    }
+
+    precondition_offsets.push_back(preconditions.size());
+  }
+
+  assert(static_cast<int>(generator_order.size()) == num_operators);
+  ranks.resize(num_operators);
+
+  for (int i = 0; i < num_operators; ++i)
+    ranks[generator_order[i].get_index()] = i;
+
+  values.resize(num_variables);
+  last_visit.assign(num_operators, 0);
+
+  cout << "Achiever index: " << achievers.size() << " achievers, built in "
+       << timer << endl;
+}
+
+bool AchieverIndex::is_applicable(OperatorID op) const {
+  int index = op.get_index();
+
+  for (int i = precondition_offsets[index]; i < precondition_offsets[index + 1];
+       ++i) {
+    const Precondition &precondition = preconditions[i];
+    int value = values[precondition.var];
+
+    if (value == unknown_values[precondition.var]) continue;
+
+    if (precondition.is_negative == (value == precondition.value))
+      return false;
+  }
+
+  return true;
+}
+
+bool AchieverIndex::is_relevant(OperatorID op, const GlobalState &state) const {
+  int index = op.get_index();
+
+  for (int i = effect_offsets[index]; i < effect_offsets[index + 1]; ++i) {
+    const FactPair &fact = effects[i];
+    if (state[fact.var] == fact.value) return true;
+  }
+
+  return false;
+}
+
+bool AchieverIndex::achieves_any(OperatorID op,
+                                 const vector<int> &state_values) const {
+  int index = op.get_index();
+
+  for (int i = effect_offsets[index]; i < effect_offsets[index + 1]; ++i) {
+    const FactPair &fact = effects[i];
+    if (state_values[fact.var] == fact.value) return true;
+  }
+
+  return false;
+}
+
+void AchieverIndex::generate_relevant_ops(
+    const GlobalState &state, vector<OperatorID> &relevant_ops) const {
+  int num_variables = values.size();
+
+  for (int var = 0; var < num_variables; ++var) values[var] = state[var];
+
+  if (num_visits == numeric_limits<int>::max()) {
+    fill(last_visit.begin(), last_visit.end(), 0);
+    num_visits = 0;
+  }
+
+  ++num_visits;
+  size_t begin = relevant_ops.size();
+
+  for (int var = 0; var < num_variables; ++var) {
+    int value = values[var];
+
+    if (value == unknown_values[var]) continue;
+
+    int row = var_offsets[var] + value;
+
+    for (int i = fact_offsets[row]; i < fact_offsets[row + 1]; ++i) {
+      OperatorID op = achievers[i];
+      int &visit = last_visit[op.get_index()];
+
+      if (visit == num_visits) continue;
+
+      visit = num_visits;
+
+      if (is_applicable(op)) relevant_ops.push_back(op);
+    }
+  }
+
+  sort(relevant_ops.begin() + begin, relevant_ops.end(),
+       [this](OperatorID op1, OperatorID op2) {
+         return ranks[op1.get_index()] < ranks[op2.get_index()];
+       });
+}
+
+}  // namespace achiever_index
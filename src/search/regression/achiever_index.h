@@ -0,0 +1,78 @@
+#ifndef ACHIEVER_INDEX_H_
+#define ACHIEVER_INDEX_H_
+
+#include "../abstract_task.h"
+#include "../operator_id.h"
+#include "regression_task.h"
+
+#include <memory>
+#include <vector>
+
+class GlobalState;
+
+namespace achiever_index {
+/*
+  Index from each fact of the root task to the operators whose forward
+  effects achieve it. A regression operator is relevant for a partial
+  state if it achieves one of the facts defined in the state, so the
+  relevant operators are enumerated from the defined facts instead of
+  scanning the effects of all applicable operators.
+
+  Regression operator i is matched with forward operator i, as in the
+  search engines. The facts, effects and preconditions are stored in
+  compressed sparse rows.
+
+  generate_relevant_ops uses scratch space and must not be called
+  concurrently.
+*/
+class AchieverIndex {
+  struct Precondition {
+    int var;
+    int value;
+    bool is_negative;
+  };
+
+  std::vector<int> unknown_values;
+  // The first row of each variable.
+  std::vector<int> var_offsets;
+  // The first achiever of each fact; fact_offsets has one extra entry.
+  std::vector<int> fact_offsets;
+  std::vector<OperatorID> achievers;
+
+  // The effects and preconditions of each operator, with one extra entry.
+  std::vector<int> effect_offsets;
+  std::vector<FactPair> effects;
+  std::vector<int> precondition_offsets;
+  std::vector<Precondition> preconditions;
+
+  // The position of each operator in the order of the successor generator.
+  std::vector<int> ranks;
+
+  mutable std::vector<int> values;
+  mutable std::vector<int> last_visit;
+  mutable int num_visits;
+
+  bool is_applicable(OperatorID op) const;
+
+ public:
+  AchieverIndex(std::shared_ptr<const tasks::RegressionTask> task,
+                const std::vector<OperatorID> &generator_order);
+
+  // Whether op achieves a fact defined in the partial state.
+  bool is_relevant(OperatorID op, const GlobalState &state) const;
+
+  // Whether op achieves a fact defined in the values, as for a goal state.
+  bool achieves_any(OperatorID op, const std::vector<int> &state_values) const;
+
+  /*
+    Appends the operators that are applicable in the partial state and
+    relevant for it, in the order of the successor generator.
+  */
+  void generate_relevant_ops(const GlobalState &state,
+                             std::vector<OperatorID> &relevant_ops) const;
+
+  int get_num_achievers() const { return achievers.size(); }
+};
+}  // namespace achiever_index
+
+#endif  // ACHIEVER_INDEX_H_
@@ -1,7 +1,10 @@
 #include "bidirectional_eager_search.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
+#include <limits>
 #include <memory>
 #include <optional.hh>
 #include <set>
@@ -14,6 +17,9 @@
 #include "../task_utils/successor_generator.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+#include "fact_mutex_table.h"
 
 using namespace std;
 
@@ -24,6 +30,10 @@ BidirectionalEagerSearch::BidirectionalEagerSearch(const Options &opts)
       prune_goal(opts.get<bool>("prune_goal")),
       is_initial(true),
       bdd(opts.get<bool>("bdd")),
+      subsumption(opts.get<bool>("subsumption")),
+      nogoods(opts.get<bool>("nogoods")),
+      bdds_released(false),
+      forward_only(false),
       initial_branching_f(-1),
       initial_branching_b(-1),
       sum_branching_f(0),
@@ -34,19 +44,38 @@ BidirectionalEagerSearch::BidirectionalEagerSearch(const Options &opts)
       d_node_value_b(-1),
       max_steps(opts.get<int>("max_steps")),
       steps(0),
+      reeval_threads(opts.get<int>("reeval_threads")),
+      eval_threads(opts.get<int>("eval_threads")),
+      concurrent(opts.get<bool>("concurrent")),
+      reevaluated_states(0),
+      reeval_time(0.0),
+      goal_state_id(StateID::no_state),
       d_node_f(StateID::no_state),
       d_node_b(StateID::no_state),
-      partial_state_task(tasks::PartialStateTask::get_partial_state_task()),
+      partial_state_task(tasks::PartialStateTask::get_partial_state_task(
+          opts.get<double>("h2_mutex_time_limit"))),
       partial_state_task_proxy(*partial_state_task),
-      regression_state_registry(partial_state_task_proxy),
+      regression_state_registry(
+          partial_state_task_proxy,
+          fact_mutex_table::FactMutexTable::get_root_mutex_table(
+              opts.get<double>("h2_mutex_time_limit"))),
       partial_state_search_space(regression_state_registry),
-      regression_task(tasks::RegressionTask::get_regression_task()),
+      regression_task(tasks::RegressionTask::get_regression_task(
+          opts.get<double>("h2_mutex_time_limit"))),
       regression_task_proxy(*regression_task),
-      regression_successor_generator(regression_task),
-      for_symbolic_closed_list(regression_task_proxy),
-      bac_symbolic_closed_list(regression_task_proxy),
+      regression_successor_generator(
+          regression_task, opts.get<bool>("flat_successor_generator"),
+          opts.get<bool>("achiever_index")),
+      for_symbolic_closed_list(regression_task_proxy, opts),
+      bac_symbolic_closed_list(regression_task_proxy, opts),
+      bac_subsumption_pruning(partial_state_task_proxy,
+                              regression_state_registry),
+      dead_end_nogoods(partial_state_task_proxy),
+      memory_budget(opts),
       current_direction(Direction::FORWARD),
-      directions(NONE),
+      forward_index(partial_state_task_proxy),
+      backward_index(partial_state_task_proxy),
+      bgg_index(partial_state_task_proxy),
       bgg_eval(opts.get<shared_ptr<FrontToFrontHeuristic>>("bgg_eval")),
       d_node_type(DNodeType(opts.get_enum("d_node_type"))),
       reeval_method(ReevalMethod(opts.get_enum("reeval"))) {
@@ -64,6 +93,29 @@ BidirectionalEagerSearch::BidirectionalEagerSearch(const Options &opts)
       opts.get_list<shared_ptr<FrontToFrontHeuristic>>("preferred_f");
   preferred_operator_evaluators[Direction::BACKWARD] =
       opts.get_list<shared_ptr<FrontToFrontHeuristic>>("preferred_b");
+
+  if (concurrent) {
+    /*
+      Heuristics keep per-evaluation data, so the directions, which are
+      evaluated in parallel, must not share them.
+    */
+    set<FrontToFrontHeuristic *> forward_heuristics;
+    set<FrontToFrontHeuristic *> backward_heuristics;
+    open_lists[Direction::FORWARD]->get_involved_heuristics(
+        forward_heuristics);
+    open_lists[Direction::BACKWARD]->get_involved_heuristics(
+        backward_heuristics);
+    if (d_node_type == BGG)
+      bgg_eval->get_involved_heuristics(backward_heuristics);
+    for (FrontToFrontHeuristic *heuristic : forward_heuristics) {
+      if (backward_heuristics.count(heuristic)) {
+        cerr << "concurrent=true requires that the forward and backward "
+             << "open lists do not share heuristics" << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+      }
+    }
+    concurrent_pool = utils::make_unique_ptr<utils::WorkerPool>(1);
+  }
 }
 
 void BidirectionalEagerSearch::initialize() {
@@ -103,6 +155,20 @@ void BidirectionalEagerSearch::initialize() {
     */
 
     path_dependent_evaluators[d].assign(evals.begin(), evals.end());
+
+    /*
+      Closed states and dead ends are only discarded when they are
+      popped, but they should not be the targets of TTBS. Neither should
+      doomed backward states, which no forward state can reach. The
+      filter only reads the search data; doomed states are marked as dead
+      ends when select_node pops them.
+    */
+    open_lists[d]->set_stale_filter([this, d](StateID id) {
+      GlobalState s = regression_state_registry.lookup_state(id);
+      SearchNode node = partial_state_search_space.get_node(s);
+      if (node.is_closed() || node.is_dead_end()) return true;
+      return nogoods && d == BACKWARD && dead_end_nogoods.has_nogood(s);
+    });
   }
 
   const GlobalState &initial_state =
@@ -110,7 +176,7 @@ void BidirectionalEagerSearch::initialize() {
   for (Evaluator *evaluator : path_dependent_evaluators[Direction::FORWARD]) {
     evaluator->notify_initial_state(initial_state);
   }
-  directions[initial_state] = Direction::FORWARD;
+  state_infos[initial_state].set_direction(Direction::FORWARD);
 
   goal_state_values = regression_task->get_goal_state_values();
   vector<int> to_be_moved = goal_state_values;
@@ -121,7 +187,7 @@ void BidirectionalEagerSearch::initialize() {
   for (Evaluator *evaluator : path_dependent_evaluators[Direction::BACKWARD]) {
     evaluator->notify_initial_state(initial_state);
   }
-  directions[global_goal_state] = Direction::BACKWARD;
+  state_infos[global_goal_state].set_direction(Direction::BACKWARD);
 
   /*
     Note: we consider the initial state as reached by a preferred
@@ -141,11 +207,12 @@ void BidirectionalEagerSearch::initialize() {
     start_f_value_statistics(Direction::FORWARD, eval_context_f);
     SearchNode node_f = partial_state_search_space.get_node(initial_state);
     node_f.open_initial();
+    if (bdd) forward_index.insert(initial_state);
 
     open_lists[Direction::FORWARD]->insert(eval_context_f,
                                            initial_state.get_id());
     if (d_node_type != FRONT_TO_END)
-      pair_states[initial_state] = global_goal_state.get_id();
+      state_infos[initial_state].set_pair_state(global_goal_state.get_id());
   }
 
   open_lists[Direction::BACKWARD]->set_goal(global_goal_state);
@@ -159,14 +226,16 @@ void BidirectionalEagerSearch::initialize() {
     start_f_value_statistics(Direction::BACKWARD, eval_context_b);
     SearchNode node_b = partial_state_search_space.get_node(global_goal_state);
     node_b.open_initial();
+    if (bdd) backward_index.insert(global_goal_state);
 
     open_lists[Direction::BACKWARD]->insert(eval_context_b,
                                             global_goal_state.get_id());
     if (d_node_type != FRONT_TO_END)
-      pair_states[global_goal_state] = initial_state.get_id();
+      state_infos[global_goal_state].set_pair_state(initial_state.get_id());
   }
 
-  d_node_f = global_goal_state.get_id();
+  goal_state_id = global_goal_state.get_id();
+  d_node_f = goal_state_id;
   d_node_b = initial_state.get_id();
 
   if (d_node_type == BGG) {
@@ -188,10 +257,48 @@ void BidirectionalEagerSearch::initialize() {
 void BidirectionalEagerSearch::print_statistics() const {
   statistics.print_detailed_statistics();
   partial_state_search_space.print_statistics();
+  regression_state_registry.print_statistics();
+
+  int state_bytes = regression_state_registry.get_state_size_in_bytes();
+  cout << "Search data per state: "
+       << state_bytes + sizeof(SearchNodeInfo) + sizeof(BidirectionalStateInfo)
+       << " bytes (state " << state_bytes << ", search node "
+       << sizeof(SearchNodeInfo) << ", bidirectional info "
+       << sizeof(BidirectionalStateInfo) << ")" << endl;
+
+  if (bdd || bdds_released) {
+    for_symbolic_closed_list.PrintStatistics("Forward");
+    bac_symbolic_closed_list.PrintStatistics("Backward");
+  }
+
+  if (subsumption) bac_subsumption_pruning.print_statistics("Backward");
+
+  if (nogoods) dead_end_nogoods.print_statistics();
+
+  if (memory_budget.is_enabled()) memory_budget.print_statistics();
+
+  if (reeval_method == ALL) {
+    cout << "Re-evaluated states: " << reevaluated_states << endl;
+    cout << "Re-evaluation time: " << reeval_time << "s (" << reeval_threads
+         << " threads)" << endl;
+  }
+
+  if (eval_threads > 1)
+    cout << "Successor evaluation threads: " << eval_threads << endl;
 }
 
 SearchStatus BidirectionalEagerSearch::step() {
-  tl::optional<SearchNode> node;
+  if (memory_budget.is_enabled()) apply_memory_budget();
+
+  // Without forward states, only the backward search can find a plan.
+  if (forward_only && !open_lists[FORWARD]->prune_stale_min()) {
+    forward_only = false;
+    cout << "Memory budget: no forward states left, resuming the backward "
+         << "search" << endl;
+  }
+
+  if (concurrent) return concurrent_step();
+
   while (true) {
     if (open_lists[Direction::FORWARD]->empty() &&
         open_lists[Direction::BACKWARD]->empty()) {
@@ -199,13 +306,31 @@ SearchStatus BidirectionalEagerSearch::step() {
       return FAILED;
     }
 
+    if (forward_only) current_direction = Direction::FORWARD;
+
     if (open_lists[Direction::FORWARD]->empty())
       current_direction = Direction::BACKWARD;
 
     if (open_lists[Direction::BACKWARD]->empty())
       current_direction = Direction::FORWARD;
 
-    StateID id = open_lists[current_direction]->remove_min();
+    tl::optional<SearchNode> node = select_node(current_direction);
+    if (!node) continue;
+
+    if (current_direction == Direction::FORWARD) {
+      ++expanded_f;
+      return forward_step(node);
+    }
+
+    ++expanded_b;
+    return backward_step(node);
+  }
+}
+
+tl::optional<SearchNode> BidirectionalEagerSearch::select_node(Direction d) {
+  tl::optional<SearchNode> node;
+  while (!open_lists[d]->empty()) {
+    StateID id = open_lists[d]->remove_min();
     // TODO is there a way we can avoid creating the state here and then
     //      recreate it outside of this function with node.get_state()?
     //      One way would be to store GlobalState objects inside SearchNodes
@@ -213,21 +338,28 @@ SearchStatus BidirectionalEagerSearch::step() {
     GlobalState s = regression_state_registry.lookup_state(id);
     node.emplace(partial_state_search_space.get_node(s));
 
-    if (node->is_closed()) continue;
+    // Doomed backward states may be marked as dead ends while open.
+    if (node->is_closed() || node->is_dead_end()) continue;
 
-    if (bdd && current_direction == BACKWARD &&
-        bac_symbolic_closed_list.IsClosed(s))
+    if (bdd && d == BACKWARD && bac_symbolic_closed_list.IsClosed(s))
       continue;
 
-    if (reeval_method == NOT_SIMILAR && current_direction == FORWARD &&
+    if (nogoods && d == BACKWARD && dead_end_nogoods.is_doomed(s)) {
+      node->mark_as_dead_end();
+      statistics.inc_dead_ends();
+      continue;
+    }
+
+    if (reeval_method == NOT_SIMILAR && d == FORWARD &&
         (d_node_type == MAX_G ||
-         (d_node_type == TTBS && !open_lists[BACKWARD]->empty()))) {
-      if (d_node_type == TTBS) {
+         (d_node_type == TTBS &&
+          (forward_only || open_lists[BACKWARD]->prune_stale_min())))) {
+      if (d_node_type == TTBS && !forward_only) {
         auto top = open_lists[BACKWARD]->get_min_value_and_entry();
         d_node_f = top.second;
       }
 
-      StateID pair_id = pair_states[s];
+      StateID pair_id = state_infos[s].get_pair_state();
 
       if (pair_id != d_node_f) {
         GlobalState frontier_state =
@@ -238,11 +370,12 @@ SearchStatus BidirectionalEagerSearch::step() {
         if (frontier_node.get_parent_state_id() != pair_id) {
           open_lists[Direction::FORWARD]->set_goal(frontier_state);
           EvaluationContext eval_context(s, node->get_g(), false, &statistics);
-          pair_states[s] = d_node_f;
+          state_infos[s].set_pair_state(d_node_f);
 
           statistics.inc_evaluated_states();
 
           if (open_lists[Direction::FORWARD]->is_dead_end(eval_context)) {
+            learn_nogood(FORWARD, eval_context, frontier_state);
             node->mark_as_dead_end();
             statistics.inc_dead_ends();
             continue;
@@ -255,15 +388,15 @@ SearchStatus BidirectionalEagerSearch::step() {
       }
     }
 
-    if (reeval_method == NOT_SIMILAR && current_direction == BACKWARD &&
+    if (reeval_method == NOT_SIMILAR && d == BACKWARD &&
         (d_node_type == MAX_G ||
-         (d_node_type == TTBS && !open_lists[FORWARD]->empty()))) {
+         (d_node_type == TTBS && open_lists[FORWARD]->prune_stale_min()))) {
       if (d_node_type == TTBS) {
         auto top = open_lists[FORWARD]->get_min_value_and_entry();
         d_node_b = top.second;
       }
 
-      StateID pair_id = pair_states[s];
+      StateID pair_id = state_infos[s].get_pair_state();
 
       if (pair_id != d_node_b) {
         GlobalState frontier_state =
@@ -275,11 +408,12 @@ SearchStatus BidirectionalEagerSearch::step() {
           open_lists[Direction::BACKWARD]->set_goal(s);
           EvaluationContext eval_context(frontier_state, node->get_g(), false,
                                          &statistics);
-          pair_states[s] = d_node_b;
+          state_infos[s].set_pair_state(d_node_b);
 
           statistics.inc_evaluated_states();
 
           if (open_lists[Direction::BACKWARD]->is_dead_end(eval_context)) {
+            learn_nogood(BACKWARD, eval_context, s);
             node->mark_as_dead_end();
             statistics.inc_dead_ends();
             continue;
@@ -301,29 +435,82 @@ SearchStatus BidirectionalEagerSearch::step() {
     node->close();
 
     if (bdd) {
-      if (current_direction == FORWARD)
+      if (d == FORWARD)
         for_symbolic_closed_list.Close(s);
-      else if (current_direction == BACKWARD)
+      else if (d == BACKWARD)
         bac_symbolic_closed_list.Close(s);
     }
 
+    if (subsumption && d == BACKWARD)
+      bac_subsumption_pruning.close(s, node->get_g());
+
     assert(!node->is_dead_end());
-    update_f_value_statistics(current_direction, eval_context);
+    update_f_value_statistics(d, eval_context);
     statistics.inc_expanded();
-    break;
+    return node;
   }
 
-  SearchStatus status = IN_PROGRESS;
+  return tl::nullopt;
+}
+
+SearchStatus BidirectionalEagerSearch::concurrent_step() {
+  tl::optional<SearchNode> node_f = select_node(FORWARD);
+  tl::optional<SearchNode> node_b =
+      forward_only && node_f ? tl::nullopt : select_node(BACKWARD);
 
-  if (current_direction == Direction::FORWARD) {
+  if (!node_f && !node_b) {
+    cout << "Completely explored state space -- no solution!" << endl;
+    return FAILED;
+  }
+
+  Expansion successors;
+  Expansion predecessors;
+
+  if (node_f) {
     ++expanded_f;
-    status = forward_step(node);
-  } else {
+    if (generate_successors(node_f, successors) == SOLVED) return SOLVED;
+  }
+
+  if (node_b) {
     ++expanded_b;
-    status = backward_step(node);
+    if (generate_predecessors(node_b, predecessors) == SOLVED) return SOLVED;
   }
 
-  return status;
+  /*
+    Evaluating the batches reads the state registry but does not change
+    any shared search data, so the forward batch is evaluated on the
+    worker of the pool. Evaluations counted there are added afterwards.
+  */
+  SearchStatistics forward_statistics(utils::Verbosity::SILENT);
+  if (node_f && node_b) {
+    concurrent_pool->run(2, [&](int job) {
+      if (job == 0)
+        evaluate_predecessors(predecessors, &statistics);
+      else
+        evaluate_successors(successors, &forward_statistics);
+    });
+  } else if (node_f) {
+    evaluate_successors(successors, &forward_statistics);
+  } else {
+    evaluate_predecessors(predecessors, &statistics);
+  }
+  statistics.inc_evaluations(forward_statistics.get_evaluations());
+
+  if (node_f) insert_successors(node_f, successors);
+
+  if (node_b && insert_predecessors(node_b, predecessors) == SOLVED)
+    return SOLVED;
+
+  if (++steps >= max_steps) {
+    steps = 0;
+
+    if (reeval_method == ALL && !forward_only) {
+      forward_reeval_all();
+      backward_reeval_all();
+    }
+  }
+
+  return IN_PROGRESS;
 }
 
 void BidirectionalEagerSearch::reward_progress(Direction d) {
@@ -378,14 +565,8 @@ bool BidirectionalEagerSearch::check_initial_and_set_plan(
     const GlobalState &state) {
   const GlobalState &initial_state =
       regression_state_registry.get_initial_state();
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
 
-  for (auto var : variables) {
-    if (state[var.get_id()] != var.get_domain_size() - 1 &&
-        state[var.get_id()] != initial_state[var.get_id()]) {
-      return false;
-    }
-  }
+  if (!regression_state_registry.subsumes(state, initial_state)) return false;
 
   Plan plan;
   partial_state_search_space.trace_path(state, plan);
@@ -403,6 +584,23 @@ bool BidirectionalEagerSearch::check_initial_and_set_plan(
 
 SearchStatus BidirectionalEagerSearch::forward_step(
     const tl::optional<SearchNode> &node) {
+  Expansion successors;
+  if (generate_successors(node, successors) == SOLVED) return SOLVED;
+  evaluate_successors(successors, &statistics);
+  insert_successors(node, successors);
+
+  if (++steps >= max_steps) {
+    current_direction = BACKWARD;
+    steps = 0;
+
+    if (reeval_method == ALL && !forward_only) backward_reeval_all();
+  }
+
+  return IN_PROGRESS;
+}
+
+SearchStatus BidirectionalEagerSearch::generate_successors(
+    const tl::optional<SearchNode> &node, Expansion &successors) {
   GlobalState state = node->get_state();
 
   if (check_goal_and_set_plan(state)) {
@@ -421,21 +619,22 @@ SearchStatus BidirectionalEagerSearch::forward_step(
         eval_context, preferred_operator_evaluator.get(), preferred_operators);
   }
 
-  StateID frontier_id;
-
-  if (d_node_type == TTBS && !open_lists[Direction::BACKWARD]->empty()) {
+  if (d_node_type == TTBS && !forward_only &&
+      open_lists[Direction::BACKWARD]->prune_stale_min()) {
     auto other_top = open_lists[Direction::BACKWARD]->get_min_value_and_entry();
     GlobalState frontier_state =
         regression_state_registry.lookup_state(other_top.second);
 
     if (check_meeting_and_set_plan(state, frontier_state)) return SOLVED;
 
-    frontier_id = frontier_state.get_id();
+    successors.frontier_id = frontier_state.get_id();
     open_lists[Direction::FORWARD]->set_goal(frontier_state);
   }
 
-  if (d_node_type == BGG || d_node_type == MAX_G) {
+  if (d_node_type == BGG || d_node_type == MAX_G ||
+      (d_node_type == TTBS && forward_only)) {
     GlobalState d_node_state = regression_state_registry.lookup_state(d_node_f);
+    successors.frontier_id = d_node_f;
     open_lists[Direction::FORWARD]->set_goal(d_node_state);
   }
 
@@ -463,7 +662,7 @@ SearchStatus BidirectionalEagerSearch::forward_step(
       evaluator->notify_state_transition(state, op_id, succ_state);
     }
 
-    if (directions[succ_state] == BACKWARD) {
+    if (state_infos[succ_state].get_direction() == BACKWARD) {
       meet_set_plan(FORWARD, state, op_id, succ_state);
       return SOLVED;
     }
@@ -480,8 +679,11 @@ SearchStatus BidirectionalEagerSearch::forward_step(
     }
 
     if (d_node_type == BGG) {
-      for (StateID b : bggs) {
-        GlobalState frontier_state = regression_state_registry.lookup_state(b);
+      StateID bgg_id = bgg_index.find_subsuming_state(succ_state);
+
+      if (bgg_id != StateID::no_state) {
+        GlobalState frontier_state =
+            regression_state_registry.lookup_state(bgg_id);
         if (check_meeting_and_set_plan(succ_state, frontier_state))
           return SOLVED;
       }
@@ -489,11 +691,52 @@ SearchStatus BidirectionalEagerSearch::forward_step(
 
     if (succ_node.is_dead_end()) continue;
 
+    successors.add(op_id, succ_state, is_preferred, succ_node.is_new());
+  }
+
+  return IN_PROGRESS;
+}
+
+void BidirectionalEagerSearch::evaluate_successors(
+    Expansion &successors, SearchStatistics *batch_statistics) {
+  successors.caches.reserve(successors.new_states.size());
+  for (const GlobalState &s : successors.new_states)
+    successors.caches.emplace_back(s);
+
+  // Without a frontier state, successors are evaluated when inserted.
+  if (successors.frontier_id == StateID::no_state) return;
+
+  GlobalState frontier_state =
+      regression_state_registry.lookup_state(successors.frontier_id);
+  // at() is safe to call concurrently, unlike operator[].
+  open_lists.at(Direction::FORWARD)
+      ->cache_batch(successors.new_states, frontier_state, successors.caches,
+                    batch_statistics, eval_threads);
+}
+
+void BidirectionalEagerSearch::insert_successors(
+    const tl::optional<SearchNode> &node, Expansion &successors) {
+  // Only the top of the other open list is remembered for re-evaluation.
+  StateID pair_id =
+      d_node_type == TTBS ? successors.frontier_id : StateID::no_state;
+
+  for (size_t i = 0; i < successors.states.size(); ++i) {
+    OperatorID op_id = successors.ops[i];
+    OperatorProxy op = task_proxy.get_operators()[op_id];
+    const GlobalState &succ_state = successors.states[i];
+    bool is_preferred = successors.preferred[i];
+    SearchNode succ_node = partial_state_search_space.get_node(succ_state);
+
+    // An earlier successor may have been the same state.
+    if (succ_node.is_dead_end()) continue;
+
     if (succ_node.is_new()) {
+      int batch_id = successors.batch_ids[i];
+      assert(batch_id != -1);
       int succ_g = node->get_g() + get_adjusted_cost(op);
 
-      EvaluationContext succ_eval_context(succ_state, succ_g, is_preferred,
-                                          &statistics);
+      EvaluationContext succ_eval_context(successors.caches[batch_id], succ_g,
+                                          is_preferred, &statistics);
       statistics.inc_evaluated_states();
 
       if (open_lists[Direction::FORWARD]->is_dead_end(succ_eval_context)) {
@@ -502,8 +745,9 @@ SearchStatus BidirectionalEagerSearch::forward_step(
         continue;
       }
       succ_node.open(*node, op, get_adjusted_cost(op));
-      directions[succ_state] = Direction::FORWARD;
-      pair_states[succ_state] = frontier_id;
+      state_infos[succ_state].set_direction(Direction::FORWARD);
+      if (bdd) forward_index.insert(succ_state);
+      state_infos[succ_state].set_pair_state(pair_id);
 
       if (d_node_type == MAX_G && succ_g > d_node_value_b) {
         d_node_b = succ_state.get_id();
@@ -514,7 +758,7 @@ SearchStatus BidirectionalEagerSearch::forward_step(
                                              succ_state.get_id());
       if (search_progress.check_progress(succ_eval_context)) {
         statistics.print_checkpoint_line(succ_node.get_g());
-        reward_progress(current_direction);
+        reward_progress(Direction::FORWARD);
       }
     } else if (succ_node.get_g() > node->get_g() + get_adjusted_cost(op)) {
       if (reopen_closed_nodes) {
@@ -525,7 +769,7 @@ SearchStatus BidirectionalEagerSearch::forward_step(
 
         EvaluationContext succ_eval_context(succ_state, succ_node.get_g(),
                                             is_preferred, &statistics);
-        pair_states[succ_state] = frontier_id;
+        state_infos[succ_state].set_pair_state(pair_id);
         open_lists[Direction::FORWARD]->insert(succ_eval_context,
                                                succ_state.get_id());
       } else {
@@ -533,19 +777,27 @@ SearchStatus BidirectionalEagerSearch::forward_step(
       }
     }
   }
+}
+
+SearchStatus BidirectionalEagerSearch::backward_step(
+    const tl::optional<SearchNode> &node) {
+  Expansion predecessors;
+  if (generate_predecessors(node, predecessors) == SOLVED) return SOLVED;
+  evaluate_predecessors(predecessors, &statistics);
+  if (insert_predecessors(node, predecessors) == SOLVED) return SOLVED;
 
   if (++steps >= max_steps) {
-    current_direction = BACKWARD;
+    current_direction = FORWARD;
     steps = 0;
 
-    if (reeval_method == ALL) backward_reeval_all();
+    if (reeval_method == ALL && !forward_only) forward_reeval_all();
   }
 
   return IN_PROGRESS;
 }
 
-SearchStatus BidirectionalEagerSearch::backward_step(
-    const tl::optional<SearchNode> &node) {
+SearchStatus BidirectionalEagerSearch::generate_predecessors(
+    const tl::optional<SearchNode> &node, Expansion &predecessors) {
   GlobalState state = node->get_state();
 
   if (check_initial_and_set_plan(state)) {
@@ -558,7 +810,8 @@ SearchStatus BidirectionalEagerSearch::backward_step(
 
   GlobalState frontier_state = regression_state_registry.get_initial_state();
 
-  if (d_node_type == TTBS && !open_lists[Direction::FORWARD]->empty()) {
+  if (d_node_type == TTBS &&
+      open_lists[Direction::FORWARD]->prune_stale_min()) {
     auto other_top = open_lists[Direction::FORWARD]->get_min_value_and_entry();
     frontier_state = regression_state_registry.lookup_state(other_top.second);
     if (check_meeting_and_set_plan(frontier_state, state)) return SOLVED;
@@ -569,7 +822,7 @@ SearchStatus BidirectionalEagerSearch::backward_step(
     if (check_meeting_and_set_plan(frontier_state, state)) return SOLVED;
   }
 
-  StateID frontier_id = frontier_state.get_id();
+  predecessors.frontier_id = frontier_state.get_id();
 
   open_lists[Direction::BACKWARD]->set_goal(state);
   EvaluationContext eval_context(frontier_state, node->get_g(), false,
@@ -582,7 +835,7 @@ SearchStatus BidirectionalEagerSearch::backward_step(
   }
 
   vector<OperatorID> applicable_ops;
-  regression_successor_generator.generate_applicable_ops(state, applicable_ops);
+  regression_successor_generator.generate_relevant_ops(state, applicable_ops);
 
   if (initial_branching_b == -1) {
     initial_branching_b = applicable_ops.size();
@@ -596,33 +849,10 @@ SearchStatus BidirectionalEagerSearch::backward_step(
   if (is_initial) is_initial = false;
 
   for (OperatorID op_id : applicable_ops) {
-    if (do_predecessor_pruning) {
-      OperatorProxy fop = task_proxy.get_operators()[op_id];
-      bool add_goal = false;
-
-      for (EffectProxy effect : fop.get_effects()) {
-        FactPair effect_pair = effect.get_fact().get_pair();
-        if (goal_state_values[effect_pair.var] == effect_pair.value) {
-          add_goal = true;
-          break;
-        }
-      }
-
-      if (!add_goal) continue;
-    }
-
-    OperatorProxy forward_op = task_proxy.get_operators()[op_id];
-    bool any = false;
-
-    for (EffectProxy effect : forward_op.get_effects()) {
-      FactPair effect_pair = effect.get_fact().get_pair();
-      if (state[effect_pair.var] == effect_pair.value) {
-        any = true;
-        break;
-      }
-    }
+    if (do_predecessor_pruning &&
+        !regression_successor_generator.achieves_any(op_id, goal_state_values))
+      continue;
 
-    if (!any) continue;
     OperatorProxy op = regression_task_proxy.get_operators()[op_id];
     if ((node->get_real_g() + op.get_cost()) >= bound) continue;
 
@@ -648,7 +878,7 @@ SearchStatus BidirectionalEagerSearch::backward_step(
       evaluator->notify_state_transition(pre_state, op_id, state);
     }
 
-    if (directions[pre_state] == FORWARD) {
+    if (state_infos[pre_state].get_direction() == FORWARD) {
       meet_set_plan(BACKWARD, pre_state, op_id, state);
       return SOLVED;
     }
@@ -670,42 +900,111 @@ SearchStatus BidirectionalEagerSearch::backward_step(
       continue;
     }
 
+    if (subsumption && pre_node.is_new() &&
+        bac_subsumption_pruning.prune(pre_state,
+                                      node->get_g() + get_adjusted_cost(op))) {
+      pre_node.close();
+      continue;
+    }
+
+    if (nogoods && pre_node.is_new() && dead_end_nogoods.is_doomed(pre_state)) {
+      pre_node.mark_as_dead_end();
+      statistics.inc_dead_ends();
+      dead_end_nogoods.count_saved_evaluations(1);
+      continue;
+    }
+
+    if (pre_node.is_dead_end()) continue;
+
+    predecessors.add(op_id, pre_state, is_preferred, pre_node.is_new());
+  }
+
+  return IN_PROGRESS;
+}
+
+void BidirectionalEagerSearch::evaluate_predecessors(
+    Expansion &predecessors, SearchStatistics *batch_statistics) {
+  /*
+    All new predecessors are evaluated against the same frontier state,
+    so we evaluate them in one batch instead of setting each of them as
+    the goal in turn.
+  */
+  GlobalState frontier_state =
+      regression_state_registry.lookup_state(predecessors.frontier_id);
+
+  if (d_node_type == BGG)
+    predecessors.bgg_values =
+        bgg_eval->evaluate_batch(regression_state_registry.get_initial_state(),
+                                 predecessors.new_states);
+
+  predecessors.caches.assign(predecessors.new_states.size(),
+                             EvaluatorCache(frontier_state));
+  // at() is safe to call concurrently, unlike operator[].
+  open_lists.at(Direction::BACKWARD)
+      ->cache_batch(frontier_state, predecessors.new_states,
+                    predecessors.caches, batch_statistics, eval_threads);
+}
+
+SearchStatus BidirectionalEagerSearch::insert_predecessors(
+    const tl::optional<SearchNode> &node, Expansion &predecessors) {
+  GlobalState state = node->get_state();
+  GlobalState frontier_state =
+      regression_state_registry.lookup_state(predecessors.frontier_id);
+  StateID frontier_id = predecessors.frontier_id;
+
+  for (size_t i = 0; i < predecessors.states.size(); ++i) {
+    OperatorID op_id = predecessors.ops[i];
+    OperatorProxy op = regression_task_proxy.get_operators()[op_id];
+    const GlobalState &pre_state = predecessors.states[i];
+    bool is_preferred = predecessors.preferred[i];
+    SearchNode pre_node = partial_state_search_space.get_node(pre_state);
+
+    // With concurrent steps, a forward successor may have been opened.
+    if (state_infos[pre_state].get_direction() == FORWARD) {
+      meet_set_plan(BACKWARD, pre_state, op_id, state);
+      return SOLVED;
+    }
+
+    // An earlier predecessor may have been the same state.
     if (pre_node.is_dead_end()) continue;
 
     if (pre_node.is_new()) {
+      int batch_id = predecessors.batch_ids[i];
+      assert(batch_id != -1);
       int succ_g = node->get_g() + get_adjusted_cost(op);
 
       if (d_node_type == BGG) {
-        const GlobalState &initial_state =
-            regression_state_registry.get_initial_state();
-        bgg_eval->set_goal(pre_state);
-        EvaluationContext pre_eval_context(initial_state, succ_g, is_preferred,
-                                           &statistics);
         statistics.inc_evaluated_states();
-        EvaluationResult er = bgg_eval->compute_result(pre_eval_context);
-        if (er.is_infinite()) continue;
+        if (predecessors.bgg_values[batch_id] == EvaluationResult::INFTY) {
+          // bgg_eval evaluates predecessors from the initial state.
+          if (nogoods && bgg_eval->dead_ends_are_reliable())
+            dead_end_nogoods.learn(pre_state);
+          continue;
+        }
 
-        if (er.get_evaluator_value() < d_node_value_f) {
-          d_node_value_f = er.get_evaluator_value();
+        if (predecessors.bgg_values[batch_id] < d_node_value_f) {
+          d_node_value_f = predecessors.bgg_values[batch_id];
           d_node_f = pre_state.get_id();
         }
 
-        bggs.push_back(pre_state_id);
+        bgg_index.insert(pre_state);
       }
 
-      open_lists[Direction::BACKWARD]->set_goal(pre_state);
-      EvaluationContext pre_eval_context(frontier_state, succ_g, is_preferred,
-                                         &statistics);
+      EvaluationContext pre_eval_context(predecessors.caches[batch_id], succ_g,
+                                         is_preferred, &statistics);
       statistics.inc_evaluated_states();
 
       if (open_lists[Direction::BACKWARD]->is_dead_end(pre_eval_context)) {
+        learn_nogood(BACKWARD, pre_eval_context, pre_state);
         pre_node.mark_as_dead_end();
         statistics.inc_dead_ends();
         continue;
       }
       pre_node.open(*node, op, get_adjusted_cost(op));
-      directions[pre_state] = Direction::BACKWARD;
-      if (d_node_type != FRONT_TO_END) pair_states[pre_state] = frontier_id;
+      state_infos[pre_state].set_direction(Direction::BACKWARD);
+      if (bdd) backward_index.insert(pre_state);
+      if (d_node_type != FRONT_TO_END)
+        state_infos[pre_state].set_pair_state(frontier_id);
 
       if (d_node_type == MAX_G && succ_g > d_node_value_f) {
         d_node_f = pre_state.get_id();
@@ -716,7 +1015,7 @@ SearchStatus BidirectionalEagerSearch::backward_step(
                                               pre_state.get_id());
       if (search_progress.check_progress(pre_eval_context)) {
         statistics.print_checkpoint_line(pre_node.get_g());
-        reward_progress(current_direction);
+        reward_progress(Direction::BACKWARD);
       }
     } else if (pre_node.get_g() > node->get_g() + get_adjusted_cost(op)) {
       if (reopen_closed_nodes) {
@@ -728,7 +1027,8 @@ SearchStatus BidirectionalEagerSearch::backward_step(
         open_lists[Direction::BACKWARD]->set_goal(pre_state);
         EvaluationContext pre_eval_context(frontier_state, pre_node.get_g(),
                                            is_preferred, &statistics);
-        if (d_node_type != FRONT_TO_END) pair_states[pre_state] = frontier_id;
+        if (d_node_type != FRONT_TO_END)
+          state_infos[pre_state].set_pair_state(frontier_id);
         open_lists[Direction::BACKWARD]->insert(pre_eval_context,
                                                 pre_state.get_id());
       } else {
@@ -737,22 +1037,30 @@ SearchStatus BidirectionalEagerSearch::backward_step(
     }
   }
 
-  if (++steps >= max_steps) {
-    current_direction = FORWARD;
-    steps = 0;
+  return IN_PROGRESS;
+}
 
-    if (reeval_method == ALL) forward_reeval_all();
-  }
+void BidirectionalEagerSearch::Expansion::add(OperatorID op_id,
+                                              const GlobalState &state,
+                                              bool is_preferred, bool is_new) {
+  ops.push_back(op_id);
+  states.push_back(state);
+  preferred.push_back(is_preferred);
 
-  return IN_PROGRESS;
+  if (is_new) {
+    batch_ids.push_back(new_states.size());
+    new_states.push_back(state);
+  } else {
+    batch_ids.push_back(-1);
+  }
 }
 
 void BidirectionalEagerSearch::forward_reeval_all() {
-  vector<EvaluationContext> contexts;
   vector<StateID> ids;
+  vector<GlobalState> states;
 
   if (d_node_type == TTBS) {
-    if (open_lists[BACKWARD]->empty()) return;
+    if (!open_lists[BACKWARD]->prune_stale_min()) return;
     auto top = open_lists[BACKWARD]->get_min_value_and_entry();
     d_node_f = top.second;
   }
@@ -760,40 +1068,54 @@ void BidirectionalEagerSearch::forward_reeval_all() {
   while (!open_lists[FORWARD]->empty()) {
     StateID id = open_lists[FORWARD]->remove_min();
     GlobalState s = regression_state_registry.lookup_state(id);
-    SearchNode node = partial_state_search_space.get_node(s);
-    StateID pair_id = pair_states[s];
 
-    if (pair_id != d_node_f) {
-      GlobalState frontier_state =
-          regression_state_registry.lookup_state(d_node_f);
+    if (state_infos[s].get_pair_state() != d_node_f) {
+      ids.push_back(id);
+      states.push_back(s);
+    }
+  }
 
-      open_lists[Direction::FORWARD]->set_goal(frontier_state);
-      EvaluationContext eval_context(s, node.get_g(), false, &statistics);
-      pair_states[s] = d_node_f;
+  if (states.empty()) return;
 
-      statistics.inc_evaluated_states();
+  auto start = chrono::steady_clock::now();
+  GlobalState frontier_state = regression_state_registry.lookup_state(d_node_f);
+  vector<EvaluatorCache> caches;
+  caches.reserve(states.size());
+  for (const GlobalState &s : states) caches.emplace_back(s);
+  open_lists[Direction::FORWARD]->cache_batch(states, frontier_state, caches,
+                                              &statistics, reeval_threads);
 
-      if (open_lists[Direction::FORWARD]->is_dead_end(eval_context)) {
-        node.mark_as_dead_end();
-        statistics.inc_dead_ends();
-      } else {
-        ids.push_back(id);
-        contexts.push_back(eval_context);
-      }
+  for (int i = 0, n = ids.size(); i < n; ++i) {
+    SearchNode node = partial_state_search_space.get_node(states[i]);
+    EvaluationContext eval_context(caches[i], node.get_g(), false,
+                                   &statistics);
+    state_infos[states[i]].set_pair_state(d_node_f);
+
+    statistics.inc_evaluated_states();
+
+    if (open_lists[Direction::FORWARD]->is_dead_end(eval_context)) {
+      learn_nogood(FORWARD, eval_context, frontier_state);
+      node.mark_as_dead_end();
+      statistics.inc_dead_ends();
+    } else {
+      open_lists[Direction::FORWARD]->insert(eval_context, ids[i]);
     }
   }
 
-  for (int i = 0, n = ids.size(); i < n; ++i) {
-    open_lists[Direction::FORWARD]->insert(contexts[i], ids[i]);
-  }
+  // Subsequent forward steps may keep evaluating against this frontier.
+  open_lists[Direction::FORWARD]->set_goal(frontier_state);
+
+  reevaluated_states += ids.size();
+  reeval_time +=
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
 }
 
 void BidirectionalEagerSearch::backward_reeval_all() {
-  vector<EvaluationContext> contexts;
   vector<StateID> ids;
+  vector<GlobalState> states;
 
   if (d_node_type == TTBS) {
-    if (open_lists[FORWARD]->empty()) return;
+    if (!open_lists[FORWARD]->prune_stale_min()) return;
     auto top = open_lists[FORWARD]->get_min_value_and_entry();
     d_node_b = top.second;
   }
@@ -801,45 +1123,227 @@ void BidirectionalEagerSearch::backward_reeval_all() {
   while (!open_lists[BACKWARD]->empty()) {
     StateID id = open_lists[BACKWARD]->remove_min();
     GlobalState s = regression_state_registry.lookup_state(id);
-    SearchNode node = partial_state_search_space.get_node(s);
-    StateID pair_id = pair_states[s];
 
-    if (pair_id != d_node_b) {
-      GlobalState frontier_state =
-          regression_state_registry.lookup_state(d_node_b);
+    if (state_infos[s].get_pair_state() != d_node_b) {
+      if (nogoods && dead_end_nogoods.is_doomed(s)) {
+        partial_state_search_space.get_node(s).mark_as_dead_end();
+        statistics.inc_dead_ends();
+        dead_end_nogoods.count_saved_evaluations(1);
+        continue;
+      }
+
+      ids.push_back(id);
+      states.push_back(s);
+    }
+  }
 
-      open_lists[Direction::BACKWARD]->set_goal(s);
-      EvaluationContext eval_context(frontier_state, node.get_g(), false,
+  if (states.empty()) return;
+
+  auto start = chrono::steady_clock::now();
+  GlobalState frontier_state = regression_state_registry.lookup_state(d_node_b);
+  vector<EvaluatorCache> caches(states.size(), EvaluatorCache(frontier_state));
+  open_lists[Direction::BACKWARD]->cache_batch(frontier_state, states, caches,
+                                               &statistics, reeval_threads);
+
+  for (int i = 0, n = ids.size(); i < n; ++i) {
+    SearchNode node = partial_state_search_space.get_node(states[i]);
+    EvaluationContext eval_context(caches[i], node.get_g(), false,
+                                   &statistics);
+    state_infos[states[i]].set_pair_state(d_node_b);
+
+    statistics.inc_evaluated_states();
+
+    if (open_lists[Direction::BACKWARD]->is_dead_end(eval_context)) {
+      learn_nogood(BACKWARD, eval_context, states[i]);
+      node.mark_as_dead_end();
+      statistics.inc_dead_ends();
+    } else {
+      open_lists[Direction::BACKWARD]->insert(eval_context, ids[i]);
+    }
+  }
+
+  reevaluated_states += ids.size();
+  reeval_time +=
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/*
+  Evaluations in both directions go from a forward state to a backward
+  state. If the forward state is the initial state, a reliable dead end
+  shows that the backward state is unreachable.
+*/
+void BidirectionalEagerSearch::learn_nogood(Direction d,
+                                            EvaluationContext &eval_context,
+                                            const GlobalState &goal) {
+  if (!nogoods) return;
+
+  const GlobalState &initial_state =
+      regression_state_registry.get_initial_state();
+
+  if (eval_context.get_state().get_id() == initial_state.get_id() &&
+      open_lists[d]->is_reliable_dead_end(eval_context))
+    dead_end_nogoods.learn(goal);
+}
+
+void BidirectionalEagerSearch::apply_memory_budget() {
+  memory_budget::Level required = memory_budget.check();
+
+  while (memory_budget.get_level() < required)
+    degrade(memory_budget::Level(static_cast<int>(memory_budget.get_level()) +
+                                 1));
+}
+
+void BidirectionalEagerSearch::degrade(memory_budget::Level level) {
+  int peak = memory_budget.get_peak_memory_in_kb();
+  int budget = memory_budget.get_budget_in_kb();
+  size_t num_states = regression_state_registry.size();
+  size_t state_bytes = regression_state_registry.get_state_size_in_bytes() +
+                       sizeof(SearchNodeInfo) + sizeof(BidirectionalStateInfo);
+  size_t bdd_bytes = for_symbolic_closed_list.GetMemoryInUse() +
+                     bac_symbolic_closed_list.GetMemoryInUse();
+  cout << "Memory budget: peak memory " << peak << " KB ("
+       << 100LL * peak / budget << "% of " << budget << " KB), " << num_states
+       << " states (" << num_states * state_bytes / 1024
+       << " KB of search data), " << bdd_bytes / 1024 << " KB of closed BDDs"
+       << endl;
+  cout << "Memory budget: entering level "
+       << memory_budget::get_level_name(level) << endl;
+
+  if (level == memory_budget::Level::NO_BDDS) {
+    /*
+      The managers are allocated even if the closed lists are unused.
+      Without the closed BDDs, meetings are no longer looked up in the
+      indices either, as without the bdd option.
+    */
+    for_symbolic_closed_list.Release();
+    bac_symbolic_closed_list.Release();
+    if (bdd) {
+      bdd = false;
+      bdds_released = true;
+      forward_index = partial_state_index::PartialStateIndex(
+          partial_state_task_proxy);
+      backward_index = partial_state_index::PartialStateIndex(
+          partial_state_task_proxy);
+    }
+    cout << "Memory budget: released " << bdd_bytes / 1024
+         << " KB of closed BDDs" << endl;
+  } else if (level == memory_budget::Level::PRUNED_BACKWARD) {
+    if (d_node_type == TTBS && open_lists[FORWARD]->prune_stale_min())
+      d_node_b = open_lists[FORWARD]->get_min_value_and_entry().second;
+
+    pair<int, int> pruned = refill_open_list(
+        BACKWARD, d_node_b, memory_budget.get_backward_open_limit());
+    cout << "Memory budget: pruned the backward open list from "
+         << pruned.first + pruned.second << " to " << pruned.second
+         << " entries" << endl;
+  } else if (level == memory_budget::Level::FORWARD_ONLY) {
+    forward_only = true;
+    cout << "Memory budget: stopped the backward search" << endl;
+
+    /*
+      Backward frontier states may be unreachable, so the forward
+      search continues as greedy best-first search towards the goal.
+    */
+    if (d_node_type != FRONT_TO_END) {
+      d_node_f = goal_state_id;
+      refill_open_list(FORWARD, d_node_f, numeric_limits<int>::max());
+      cout << "Memory budget: re-evaluated the forward open list against "
+           << "the goal" << endl;
+    }
+  }
+
+  memory_budget.enter(level);
+}
+
+/*
+  The open list can only be filled by evaluating, so the kept states are
+  evaluated again, in chunks to bound the memory of the caches. While
+  the open list is drained, its memory is released, and the kept states
+  take four bytes each plus one bit per registered state to skip
+  duplicate entries. The removed states stay open in the search space,
+  so they are only inserted again if they are reopened.
+*/
+pair<int, int> BidirectionalEagerSearch::refill_open_list(Direction d,
+                                                          StateID frontier_id,
+                                                          int limit) {
+  const size_t chunk_size = 1024;
+  vector<StateID> ids;
+  vector<bool> is_kept(regression_state_registry.size(), false);
+  int num_removed = 0;
+  int num_kept = 0;
+
+  while (!open_lists[d]->empty()) {
+    StateID id = open_lists[d]->remove_min();
+
+    if (static_cast<int>(ids.size()) < limit && !is_kept[id.get_value()]) {
+      GlobalState s = regression_state_registry.lookup_state(id);
+      SearchNode node = partial_state_search_space.get_node(s);
+
+      if (!node.is_closed() && !node.is_dead_end()) {
+        is_kept[id.get_value()] = true;
+        ids.push_back(id);
+        continue;
+      }
+    }
+
+    ++num_removed;
+  }
+
+  vector<bool>().swap(is_kept);
+  GlobalState frontier_state =
+      regression_state_registry.lookup_state(frontier_id);
+
+  for (size_t begin = 0; begin < ids.size(); begin += chunk_size) {
+    size_t end = min(ids.size(), begin + chunk_size);
+    vector<GlobalState> states;
+    states.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i)
+      states.push_back(regression_state_registry.lookup_state(ids[i]));
+
+    vector<EvaluatorCache> caches;
+
+    if (d == FORWARD) {
+      caches.reserve(states.size());
+      for (const GlobalState &s : states) caches.emplace_back(s);
+      open_lists[d]->cache_batch(states, frontier_state, caches, &statistics,
+                                 reeval_threads);
+    } else {
+      caches.assign(states.size(), EvaluatorCache(frontier_state));
+      open_lists[d]->cache_batch(frontier_state, states, caches, &statistics,
+                                 reeval_threads);
+    }
+
+    for (size_t i = 0; i < states.size(); ++i) {
+      SearchNode node = partial_state_search_space.get_node(states[i]);
+      EvaluationContext eval_context(caches[i], node.get_g(), false,
                                      &statistics);
-      pair_states[s] = d_node_b;
+      if (d_node_type != FRONT_TO_END)
+        state_infos[states[i]].set_pair_state(frontier_id);
 
       statistics.inc_evaluated_states();
 
-      if (open_lists[Direction::BACKWARD]->is_dead_end(eval_context)) {
+      if (open_lists[d]->is_dead_end(eval_context)) {
+        learn_nogood(d, eval_context,
+                     d == FORWARD ? frontier_state : states[i]);
         node.mark_as_dead_end();
         statistics.inc_dead_ends();
+        ++num_removed;
       } else {
-        ids.push_back(id);
-        contexts.push_back(eval_context);
+        open_lists[d]->insert(eval_context, states[i].get_id());
+        ++num_kept;
       }
     }
   }
 
-  for (int i = 0, n = ids.size(); i < n; ++i) {
-    open_lists[Direction::BACKWARD]->insert(contexts[i], ids[i]);
-  }
+  // Subsequent forward steps may keep evaluating against this frontier.
+  if (d == FORWARD) open_lists[d]->set_goal(frontier_state);
+
+  return make_pair(num_removed, num_kept);
 }
 
 bool BidirectionalEagerSearch::check_meeting_and_set_plan(
     const GlobalState &s_f, const GlobalState &s_b) {
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
-
-  for (auto var : variables) {
-    if (s_b[var.get_id()] != var.get_domain_size() - 1 &&
-        s_f[var.get_id()] != s_b[var.get_id()]) {
-      return false;
-    }
-  }
+  if (!regression_state_registry.subsumes(s_b, s_f)) return false;
 
   Plan plan;
   partial_state_search_space.trace_path(s_f, plan);
@@ -889,63 +1393,22 @@ void BidirectionalEagerSearch::meet_set_plan(Direction d,
 
 StateID BidirectionalEagerSearch::get_subsuming_state_id(
     const GlobalState &state) const {
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
-
-  for (StateID state_id : regression_state_registry) {
-    GlobalState another_state =
-        regression_state_registry.lookup_state(state_id);
-
-    if (directions[another_state] == FORWARD) continue;
-
-    bool any = false;
-
-    for (auto var : variables) {
-      if (another_state[var.get_id()] != var.get_domain_size() - 1 &&
-          state[var.get_id()] != another_state[var.get_id()]) {
-        any = true;
-        break;
-      }
-    }
-
-    if (any) continue;
-
-    return state_id;
-  }
-
-  return StateID::no_state;
+  return backward_index.find_subsuming_state(state);
 }
 
 StateID BidirectionalEagerSearch::get_subsumed_state_id(
     const GlobalState &state) const {
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
-
-  for (StateID state_id : regression_state_registry) {
-    GlobalState another_state =
-        regression_state_registry.lookup_state(state_id);
-
-    if (directions[another_state] == BACKWARD) continue;
-
-    bool any = false;
-
-    for (auto var : variables) {
-      if (state[var.get_id()] != var.get_domain_size() - 1 &&
-          state[var.get_id()] != another_state[var.get_id()]) {
-        any = true;
-        break;
-      }
-    }
-
-    if (any) continue;
-
-    return state_id;
-  }
-
-  return StateID::no_state;
+  return forward_index.find_subsumed_state(state);
 }
 
 void add_options_to_parser(OptionParser &parser) {
   SearchEngine::add_pruning_option(parser);
   SearchEngine::add_options_to_parser(parser);
+  regression_successor_generator::add_options_to_parser(parser);
+  fact_mutex_table::add_options_to_parser(parser);
+  subsumption_pruning::add_options_to_parser(parser);
+  nogood_store::add_options_to_parser(parser);
+  memory_budget::add_options_to_parser(parser);
 }
 
 }  // namespace bidirectional_eager_search
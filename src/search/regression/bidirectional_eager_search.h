@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <optional.hh>
+#include <utility>
 #include <vector>
 
 #include "../front_to_front/front_to_front_heuristic.h"
@@ -12,9 +13,15 @@
 #include "../search_engine.h"
 #include "../search_progress.h"
 #include "../search_space.h"
+#include "../utils/worker_pool.h"
+#include "bidirectional_state_info.h"
+#include "memory_budget.h"
+#include "nogood_store.h"
+#include "partial_state_index.h"
 #include "regression_state_registry.h"
 #include "regression_successor_generator.h"
 #include "regression_task.h"
+#include "subsumption_pruning.h"
 #include "symbolic_closed.h"
 
 class Evaluator;
@@ -32,6 +39,12 @@ class BidirectionalEagerSearch : public SearchEngine {
   bool prune_goal;
   bool is_initial;
   bool bdd;
+  bool subsumption;
+  bool nogoods;
+  // Set when the memory budget drops the closed BDDs.
+  bool bdds_released;
+  // Set when the memory budget stops the backward search.
+  bool forward_only;
   std::vector<int> goal_state_values;
   int initial_branching_f;
   int initial_branching_b;
@@ -43,6 +56,36 @@ class BidirectionalEagerSearch : public SearchEngine {
   int d_node_value_b;
   int max_steps;
   int steps;
+  const int reeval_threads;
+  const int eval_threads;
+  const bool concurrent;
+  // Evaluates the forward batch of concurrent steps.
+  std::unique_ptr<utils::WorkerPool> concurrent_pool;
+  int reevaluated_states;
+  // Wall-clock seconds spent in forward_reeval_all and backward_reeval_all.
+  double reeval_time;
+
+  /*
+    The states generated by one expansion. They are generated, evaluated
+    in one batch and inserted into the open list in separate phases.
+    Only the evaluation phase does not change shared search data, so
+    concurrent steps evaluate the batches of both directions in parallel.
+  */
+  struct Expansion {
+    // The state that the new states are evaluated against, if any.
+    StateID frontier_id;
+    std::vector<OperatorID> ops;
+    std::vector<GlobalState> states;
+    std::vector<bool> preferred;
+    // Index of each state in new_states or -1 if it is not new.
+    std::vector<int> batch_ids;
+    std::vector<GlobalState> new_states;
+    std::vector<EvaluatorCache> caches;
+    std::vector<int> bgg_values;
+
+    void add(OperatorID op_id, const GlobalState &state, bool is_preferred,
+             bool is_new);
+  };
 
   std::unordered_map<Direction, std::shared_ptr<FrontToFrontStateOpenList>>
       open_lists;
@@ -53,6 +96,8 @@ class BidirectionalEagerSearch : public SearchEngine {
   std::unordered_map<Direction,
                      std::vector<std::shared_ptr<FrontToFrontHeuristic>>>
       preferred_operator_evaluators;
+  // The registered goal state, which the backward search starts from.
+  StateID goal_state_id;
   StateID d_node_f;
   StateID d_node_b;
 
@@ -65,10 +110,35 @@ class BidirectionalEagerSearch : public SearchEngine {
                                   const GlobalState &s_b);
   void meet_set_plan(Direction d, const GlobalState &s_f, OperatorID op_id,
                      const GlobalState &s_b);
+  tl::optional<SearchNode> select_node(Direction d);
   SearchStatus forward_step(const tl::optional<SearchNode> &node);
   SearchStatus backward_step(const tl::optional<SearchNode> &node);
+  SearchStatus concurrent_step();
+  SearchStatus generate_successors(const tl::optional<SearchNode> &node,
+                                   Expansion &successors);
+  void evaluate_successors(Expansion &successors,
+                           SearchStatistics *batch_statistics);
+  void insert_successors(const tl::optional<SearchNode> &node,
+                         Expansion &successors);
+  SearchStatus generate_predecessors(const tl::optional<SearchNode> &node,
+                                     Expansion &predecessors);
+  void evaluate_predecessors(Expansion &predecessors,
+                             SearchStatistics *batch_statistics);
+  SearchStatus insert_predecessors(const tl::optional<SearchNode> &node,
+                                   Expansion &predecessors);
   void forward_reeval_all();
   void backward_reeval_all();
+  void learn_nogood(Direction d, EvaluationContext &eval_context,
+                    const GlobalState &goal);
+  void apply_memory_budget();
+  void degrade(memory_budget::Level level);
+  /*
+    Empty the open list of direction d and insert at most limit of its
+    best live states again, evaluated against frontier_id. Returns the
+    numbers of removed and kept entries.
+  */
+  std::pair<int, int> refill_open_list(Direction d, StateID frontier_id,
+                                       int limit);
 
  protected:
   const std::shared_ptr<AbstractTask> partial_state_task;
@@ -81,10 +151,14 @@ class BidirectionalEagerSearch : public SearchEngine {
       regression_successor_generator;
   symbolic_closed::SymbolicClosedList for_symbolic_closed_list;
   symbolic_closed::SymbolicClosedList bac_symbolic_closed_list;
-  PerStateInformation<StateID> pair_states;
+  subsumption_pruning::SubsumptionPruning bac_subsumption_pruning;
+  nogood_store::NogoodStore dead_end_nogoods;
+  memory_budget::MemoryBudget memory_budget;
   Direction current_direction;
-  PerStateInformation<Direction> directions;
-  std::vector<StateID> bggs;
+  PerStateInformation<BidirectionalStateInfo> state_infos;
+  partial_state_index::PartialStateIndex forward_index;
+  partial_state_index::PartialStateIndex backward_index;
+  partial_state_index::PartialStateIndex bgg_index;
   std::shared_ptr<FrontToFrontHeuristic> bgg_eval;
 
   virtual void initialize() override;
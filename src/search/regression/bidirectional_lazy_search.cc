@@ -9,6 +9,8 @@
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
+#include "fact_mutex_table.h"
+
 #include <algorithm>
 #include <limits>
 #include <vector>
@@ -33,18 +35,26 @@ BidirectionalLazySearch::BidirectionalLazySearch(const Options &opts)
       h_min_bgg(-1),
       arg_min_bgg(StateID::no_state),
       rng(utils::parse_rng_from_options(opts)),
-      partial_state_task(tasks::PartialStateTask::get_partial_state_task()),
+      partial_state_task(tasks::PartialStateTask::get_partial_state_task(
+          opts.get<double>("h2_mutex_time_limit"))),
       partial_state_task_proxy(*partial_state_task),
-      regression_state_registry(partial_state_task_proxy),
+      regression_state_registry(
+          partial_state_task_proxy,
+          fact_mutex_table::FactMutexTable::get_root_mutex_table(
+              opts.get<double>("h2_mutex_time_limit"))),
       partial_state_search_space(regression_state_registry),
-      regression_task(tasks::RegressionTask::get_regression_task()),
+      regression_task(tasks::RegressionTask::get_regression_task(
+          opts.get<double>("h2_mutex_time_limit"))),
       regression_task_proxy(*regression_task),
-      regression_successor_generator(regression_task),
-      for_symbolic_closed_list(regression_task_proxy),
-      bac_symbolic_closed_list(regression_task_proxy),
+      regression_successor_generator(
+          regression_task, opts.get<bool>("flat_successor_generator"),
+          opts.get<bool>("achiever_index")),
+      for_symbolic_closed_list(regression_task_proxy, opts),
+      bac_symbolic_closed_list(regression_task_proxy, opts),
       current_direction(FORWARD),
-      directions(NONE),
-      pair_state(StateID::no_state),
+      forward_index(partial_state_task_proxy),
+      backward_index(partial_state_task_proxy),
+      bgg_index(partial_state_task_proxy),
       for_current_state(regression_state_registry.get_initial_state()),
       for_current_predecessor_id(StateID::no_state),
       for_current_operator_id(OperatorID::no_operator),
@@ -111,8 +121,8 @@ void BidirectionalLazySearch::initialize() {
     evaluator->notify_initial_state(initial_state);
   }
 
-  directions[for_current_state] = FORWARD;
-  directions[bac_current_state] = BACKWARD;
+  state_infos[for_current_state].set_direction(FORWARD);
+  state_infos[bac_current_state].set_direction(BACKWARD);
 }
 
 vector<OperatorID> BidirectionalLazySearch::get_successor_operators(
@@ -142,8 +152,8 @@ vector<OperatorID> BidirectionalLazySearch::get_successor_operators(
 vector<OperatorID> BidirectionalLazySearch::get_predecessor_operators(
     const ordered_set::OrderedSet<OperatorID> &preferred_operators) const {
   vector<OperatorID> applicable_operators;
-  regression_successor_generator.generate_applicable_ops(bac_current_state,
-                                                         applicable_operators);
+  regression_successor_generator.generate_relevant_ops(bac_current_state,
+                                                       applicable_operators);
 
   if (randomize_successors) {
     rng->shuffle(applicable_operators);
@@ -253,9 +263,10 @@ SearchStatus BidirectionalLazySearch::for_fetch_next_state() {
         auto frontier_node =
             partial_state_search_space.get_node(frontier_state);
 
-        if (pair_state[parent_state] != frontier_node.get_parent_state_id()) {
+        if (state_infos[parent_state].get_pair_state() !=
+            frontier_node.get_parent_state_id()) {
           parent_id = new_parent_id;
-          pair_state[parent_state] = frontier_state.get_id();
+          state_infos[parent_state].set_pair_state(frontier_state.get_id());
           for_open_list->set_goal(frontier_state);
           auto parent_node = partial_state_search_space.get_node(parent_state);
           parent_eval_context = EvaluationContext(
@@ -294,7 +305,7 @@ SearchStatus BidirectionalLazySearch::for_fetch_next_state() {
     for_current_g = pred_node.get_g() + get_adjusted_cost(current_operator);
     for_current_real_g = pred_node.get_real_g() + current_operator.get_cost();
 
-    if (directions[for_current_state] == BACKWARD) {
+    if (state_infos[for_current_state].get_direction() == BACKWARD) {
       meet_set_plan(FORWARD, current_predecessor, for_current_operator_id,
                     for_current_state);
       return SOLVED;
@@ -312,15 +323,17 @@ SearchStatus BidirectionalLazySearch::for_fetch_next_state() {
       }
 
       if (use_bgg) {
-        for (StateID b : bggs) {
+        StateID bgg_id = bgg_index.find_subsuming_state(for_current_state);
+
+        if (bgg_id != StateID::no_state) {
           GlobalState frontier_state =
-              regression_state_registry.lookup_state(b);
+              regression_state_registry.lookup_state(bgg_id);
           if (check_meeting_and_set_plan(for_current_state, frontier_state))
             return SOLVED;
         }
       }
 
-      directions[for_current_state] = FORWARD;
+      state_infos[for_current_state].set_direction(FORWARD);
     }
 
     break;
@@ -341,7 +354,8 @@ SearchStatus BidirectionalLazySearch::for_fetch_next_state() {
         regression_state_registry.lookup_state(top.second.first);
     for_open_list->set_goal(frontier_state);
 
-    if (reeval) pair_state[for_current_state] = frontier_state.get_id();
+    if (reeval)
+      state_infos[for_current_state].set_pair_state(frontier_state.get_id());
   } else if (use_bgg) {
     GlobalState arg_min_bgg_state =
         regression_state_registry.lookup_state(arg_min_bgg);
@@ -389,8 +403,9 @@ SearchStatus BidirectionalLazySearch::bac_fetch_next_state() {
         auto frontier_node =
             partial_state_search_space.get_node(frontier_state);
 
-        if (pair_state[parent_state] != frontier_node.get_parent_state_id()) {
-          pair_state[parent_state] = frontier_state.get_id();
+        if (state_infos[parent_state].get_pair_state() !=
+            frontier_node.get_parent_state_id()) {
+          state_infos[parent_state].set_pair_state(frontier_state.get_id());
           parent_id = new_parent_id;
           bac_open_list->set_goal(parent_state);
 
@@ -420,19 +435,9 @@ SearchStatus BidirectionalLazySearch::bac_fetch_next_state() {
       parent_id = StateID::no_state;
     }
 
-    OperatorProxy forward_op =
-        task_proxy.get_operators()[current_operator.get_id()];
-    bool any = false;
-
-    for (EffectProxy effect : forward_op.get_effects()) {
-      FactPair effect_pair = effect.get_fact().get_pair();
-      if (current_successor[effect_pair.var] == effect_pair.value) {
-        any = true;
-        break;
-      }
-    }
-
-    if (!any) continue;
+    if (!regression_successor_generator.is_relevant(
+            OperatorID(current_operator.get_id()), current_successor))
+      continue;
 
     state_id = regression_state_registry.get_predecessor_state(
         current_successor, current_operator);
@@ -450,7 +455,7 @@ SearchStatus BidirectionalLazySearch::bac_fetch_next_state() {
     bac_current_g = pred_node.get_g() + get_adjusted_cost(current_operator);
     bac_current_real_g = pred_node.get_real_g() + current_operator.get_cost();
 
-    if (directions[bac_current_state] == FORWARD) {
+    if (state_infos[bac_current_state].get_direction() == FORWARD) {
       meet_set_plan(BACKWARD, bac_current_state, bac_current_operator_id,
                     current_successor);
       return SOLVED;
@@ -467,7 +472,7 @@ SearchStatus BidirectionalLazySearch::bac_fetch_next_state() {
         }
       }
 
-      directions[bac_current_state] = BACKWARD;
+      state_infos[bac_current_state].set_direction(BACKWARD);
     }
 
     /*
@@ -489,7 +494,8 @@ SearchStatus BidirectionalLazySearch::bac_fetch_next_state() {
     bac_current_eval_context =
         EvaluationContext(frontier_state, bac_current_g, true, &statistics);
 
-    if (reeval) pair_state[bac_current_state] = frontier_state.get_id();
+    if (reeval)
+      state_infos[bac_current_state].set_pair_state(frontier_state.get_id());
   } else {
     bac_current_eval_context =
         EvaluationContext(regression_state_registry.get_initial_state(),
@@ -556,7 +562,10 @@ SearchStatus BidirectionalLazySearch::for_step() {
         }
       }
       node.close();
-      if (bdd) for_symbolic_closed_list.Close(for_current_state);
+      if (bdd) {
+        for_symbolic_closed_list.Close(for_current_state);
+        forward_index.insert(for_current_state);
+      }
       if (front_to_front && !bac_open_list->empty()) {
         auto top = bac_open_list->get_min_value_and_entry();
         GlobalState frontier_state =
@@ -607,9 +616,12 @@ SearchStatus BidirectionalLazySearch::bac_step() {
 
   SearchNode node = partial_state_search_space.get_node(bac_current_state);
 
-  if (node.is_new() && bdd &&
-      !bac_symbolic_closed_list.CloseIfNot(bac_current_state))
-    node.close();
+  if (node.is_new() && bdd) {
+    if (bac_symbolic_closed_list.CloseIfNot(bac_current_state))
+      backward_index.insert(bac_current_state);
+    else
+      node.close();
+  }
 
   bool reopen = reopen_closed_nodes && !node.is_new() && !node.is_dead_end() &&
                 (for_current_g < node.get_g());
@@ -639,7 +651,7 @@ SearchStatus BidirectionalLazySearch::bac_step() {
         arg_min_bgg = bac_current_state.get_id();
       }
 
-      bggs.push_back(bac_current_state.get_id());
+      bgg_index.insert(bac_current_state);
     }
 
     statistics.inc_evaluated_states();
@@ -707,6 +719,19 @@ void BidirectionalLazySearch::bac_reward_progress() {
 void BidirectionalLazySearch::print_statistics() const {
   statistics.print_detailed_statistics();
   partial_state_search_space.print_statistics();
+  regression_state_registry.print_statistics();
+
+  int state_bytes = regression_state_registry.get_state_size_in_bytes();
+  cout << "Search data per state: "
+       << state_bytes + sizeof(SearchNodeInfo) + sizeof(BidirectionalStateInfo)
+       << " bytes (state " << state_bytes << ", search node "
+       << sizeof(SearchNodeInfo) << ", bidirectional info "
+       << sizeof(BidirectionalStateInfo) << ")" << endl;
+
+  if (bdd) {
+    for_symbolic_closed_list.PrintStatistics("Forward");
+    bac_symbolic_closed_list.PrintStatistics("Backward");
+  }
 }
 
 bool BidirectionalLazySearch::check_goal_and_set_plan(
@@ -725,14 +750,8 @@ bool BidirectionalLazySearch::check_initial_and_set_plan(
     const GlobalState &state) {
   const GlobalState &initial_state =
       regression_state_registry.get_initial_state();
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
 
-  for (auto var : variables) {
-    if (state[var.get_id()] != var.get_domain_size() - 1 &&
-        state[var.get_id()] != initial_state[var.get_id()]) {
-      return false;
-    }
-  }
+  if (!regression_state_registry.subsumes(state, initial_state)) return false;
 
   Plan plan;
   partial_state_search_space.trace_path(state, plan);
@@ -744,14 +763,7 @@ bool BidirectionalLazySearch::check_initial_and_set_plan(
 
 bool BidirectionalLazySearch::check_meeting_and_set_plan(
     const GlobalState &s_f, const GlobalState &s_b) {
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
-
-  for (auto var : variables) {
-    if (s_b[var.get_id()] != var.get_domain_size() - 1 &&
-        s_f[var.get_id()] != s_b[var.get_id()]) {
-      return false;
-    }
-  }
+  if (!regression_state_registry.subsumes(s_b, s_f)) return false;
 
   Plan plan;
   partial_state_search_space.trace_path(s_f, plan);
@@ -788,58 +800,12 @@ void BidirectionalLazySearch::meet_set_plan(Direction d, const GlobalState &s_f,
 
 StateID BidirectionalLazySearch::get_subsuming_state_id(
     const GlobalState &state) const {
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
-
-  for (StateID state_id : regression_state_registry) {
-    GlobalState another_state =
-        regression_state_registry.lookup_state(state_id);
-
-    if (directions[another_state] == FORWARD) continue;
-
-    bool any = false;
-
-    for (auto var : variables) {
-      if (another_state[var.get_id()] != var.get_domain_size() - 1 &&
-          state[var.get_id()] != another_state[var.get_id()]) {
-        any = true;
-        break;
-      }
-    }
-
-    if (any) continue;
-
-    return state_id;
-  }
-
-  return StateID::no_state;
+  return backward_index.find_subsuming_state(state);
 }
 
 StateID BidirectionalLazySearch::get_subsumed_state_id(
     const GlobalState &state) const {
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
-
-  for (StateID state_id : regression_state_registry) {
-    GlobalState another_state =
-        regression_state_registry.lookup_state(state_id);
-
-    if (directions[another_state] == BACKWARD) continue;
-
-    bool any = false;
-
-    for (auto var : variables) {
-      if (state[var.get_id()] != var.get_domain_size() - 1 &&
-          state[var.get_id()] != another_state[var.get_id()]) {
-        any = true;
-        break;
-      }
-    }
-
-    if (any) continue;
-
-    return state_id;
-  }
-
-  return StateID::no_state;
+  return forward_index.find_subsumed_state(state);
 }
 
 void add_options_to_parser(OptionParser &parser) {
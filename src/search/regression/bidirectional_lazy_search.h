@@ -12,6 +12,8 @@
 
 #include "../front_to_front/front_to_front_heuristic.h"
 #include "../front_to_front/front_to_front_open_list.h"
+#include "bidirectional_state_info.h"
+#include "partial_state_index.h"
 #include "regression_state_registry.h"
 #include "regression_successor_generator.h"
 #include "regression_task.h"
@@ -64,8 +66,10 @@ class BidirectionalLazySearch : public SearchEngine {
   symbolic_closed::SymbolicClosedList for_symbolic_closed_list;
   symbolic_closed::SymbolicClosedList bac_symbolic_closed_list;
   Direction current_direction;
-  PerStateInformation<Direction> directions;
-  PerStateInformation<StateID> pair_state;
+  PerStateInformation<BidirectionalStateInfo> state_infos;
+  partial_state_index::PartialStateIndex forward_index;
+  partial_state_index::PartialStateIndex backward_index;
+  partial_state_index::PartialStateIndex bgg_index;
 
   GlobalState for_current_state;
   StateID for_current_predecessor_id;
@@ -84,7 +88,6 @@ class BidirectionalLazySearch : public SearchEngine {
   EdgeOpenListEntry previous_entry;
   StateID parent_id;
   EvaluationContext parent_eval_context;
-  std::vector<StateID> bggs;
   std::shared_ptr<FrontToFrontHeuristic> bgg_eval;
 
   virtual void initialize() override;
@@ -0,0 +1,44 @@
+#ifndef BIDIRECTIONAL_STATE_INFO_H_
+#define BIDIRECTIONAL_STATE_INFO_H_
+
+#include "../state_id.h"
+#include "../utils/system.h"
+
+#include <cassert>
+
+/*
+  Per-state information of the bidirectional engines that is not part
+  of the search node: the direction that generated the state and the
+  state of the opposite frontier that its heuristic value was computed
+  against. Both are packed into four bytes, so one registry lookup
+  reads both. Directions are the NONE/FORWARD/BACKWARD values of the
+  engines, and the pair state is StateID::no_state until it is set.
+  Setting a pair state with an ID above 2^29 - 1 aborts the planner.
+*/
+class BidirectionalStateInfo {
+  static const int MAX_STATE_ID = (1 << 29) - 1;
+
+  unsigned int direction : 2;
+  int pair_state_id : 30;
+
+ public:
+  BidirectionalStateInfo()
+      : direction(0), pair_state_id(StateID::no_state.get_value()) {}
+
+  int get_direction() const { return direction; }
+
+  void set_direction(int d) {
+    assert(d >= 0 && d < 4);
+    direction = d;
+  }
+
+  StateID get_pair_state() const { return StateID(pair_state_id); }
+
+  void set_pair_state(StateID id) {
+    if (id.get_value() > MAX_STATE_ID)
+      ABORT("State ID does not fit into the pair state field.");
+    pair_state_id = id.get_value();
+  }
+};
+
+#endif  // BIDIRECTIONAL_STATE_INFO_H_
@@ -10,6 +10,7 @@
 #include "../front_to_front/front_to_front_open_list_factory.h"
 #include "../task_utils/successor_generator.h"
 #include "../task_utils/task_properties.h"
+#include "fact_mutex_table.h"
 #include "regression_successor_generator.h"
 
 #include <cassert>
@@ -33,13 +34,20 @@ EagerSFBS::EagerSFBS(const Options &opts)
       preferred_operator_evaluators(
           opts.get_list<shared_ptr<FrontToFrontHeuristic>>("preferred")),
       directions(NONE),
-      partial_state_task(tasks::PartialStateTask::get_partial_state_task()),
+      partial_state_task(tasks::PartialStateTask::get_partial_state_task(
+          opts.get<double>("h2_mutex_time_limit"))),
       partial_state_task_proxy(*partial_state_task),
-      regression_state_registry(partial_state_task_proxy),
+      regression_state_registry(
+          partial_state_task_proxy,
+          fact_mutex_table::FactMutexTable::get_root_mutex_table(
+              opts.get<double>("h2_mutex_time_limit"))),
       partial_state_search_space(regression_state_registry),
-      regression_task(tasks::RegressionTask::get_regression_task()),
+      regression_task(tasks::RegressionTask::get_regression_task(
+          opts.get<double>("h2_mutex_time_limit"))),
       regression_task_proxy(*regression_task),
-      regression_successor_generator(regression_task) {}
+      regression_successor_generator(
+          regression_task, opts.get<bool>("flat_successor_generator"),
+          opts.get<bool>("achiever_index")) {}
 
 void EagerSFBS::initialize() {
   cout << "Conducting best first search"
@@ -111,6 +119,9 @@ void EagerSFBS::initialize() {
 void EagerSFBS::print_statistics() const {
   statistics.print_detailed_statistics();
   partial_state_search_space.print_statistics();
+  regression_state_registry.print_statistics();
+  closed_list.print_statistics("Closed frontier pairs");
+  open_list->print_statistics();
 }
 
 SearchStatus EagerSFBS::step() {
@@ -130,9 +141,7 @@ SearchStatus EagerSFBS::step() {
     pair<int, int> id_pair =
         make_pair(frontier.first.get_value(), frontier.second.get_value());
 
-    if (closed_list.find(id_pair) != closed_list.end()) continue;
-
-    closed_list.insert(id_pair);
+    if (!closed_list.insert(id_pair.first, id_pair.second)) continue;
 
     GlobalState s_f = regression_state_registry.lookup_state(frontier.first);
     GlobalState s_b = regression_state_registry.lookup_state(frontier.second);
@@ -251,7 +260,7 @@ SearchStatus EagerSFBS::forward_step(const tl::optional<SearchNode> &n_f,
     auto succ_id_pair =
         make_pair(succ_state.get_id().get_value(), s_b.get_id().get_value());
 
-    if (closed_list.find(succ_id_pair) == closed_list.end()) {
+    if (!closed_list.contains(succ_id_pair.first, succ_id_pair.second)) {
       int succ_g = n_f->get_g() + get_adjusted_cost(op);
 
       open_list->set_goal(s_b);
@@ -302,7 +311,7 @@ SearchStatus EagerSFBS::backward_step(const tl::optional<SearchNode> &n_f,
   GlobalState s_b = n_b->get_state();
 
   vector<OperatorID> applicable_ops;
-  regression_successor_generator.generate_applicable_ops(s_b, applicable_ops);
+  regression_successor_generator.generate_relevant_ops(s_b, applicable_ops);
 
   ordered_set::OrderedSet<OperatorID> preferred_operators;
 
@@ -319,33 +328,9 @@ SearchStatus EagerSFBS::backward_step(const tl::optional<SearchNode> &n_f,
   if (is_initial) is_initial = false;
 
   for (OperatorID op_id : applicable_ops) {
-    if (do_predecessor_pruning) {
-      OperatorProxy fop = task_proxy.get_operators()[op_id];
-      bool add_goal = false;
-
-      for (EffectProxy effect : fop.get_effects()) {
-        FactPair effect_pair = effect.get_fact().get_pair();
-        if (goal_state_values[effect_pair.var] == effect_pair.value) {
-          add_goal = true;
-          break;
-        }
-      }
-
-      if (!add_goal) continue;
-    }
-
-    OperatorProxy forward_op = task_proxy.get_operators()[op_id];
-    bool any = false;
-
-    for (EffectProxy effect : forward_op.get_effects()) {
-      FactPair effect_pair = effect.get_fact().get_pair();
-      if (s_b[effect_pair.var] == effect_pair.value) {
-        any = true;
-        break;
-      }
-    }
-
-    if (!any) continue;
+    if (do_predecessor_pruning &&
+        !regression_successor_generator.achieves_any(op_id, goal_state_values))
+      continue;
 
     OperatorProxy op = regression_task_proxy.get_operators()[op_id];
     if ((n_b->get_real_g() + op.get_cost()) >= bound) continue;
@@ -387,7 +372,7 @@ SearchStatus EagerSFBS::backward_step(const tl::optional<SearchNode> &n_f,
     auto pre_id_pair =
         make_pair(s_f.get_id().get_value(), pre_state.get_id().get_value());
 
-    if (closed_list.find(pre_id_pair) == closed_list.end()) {
+    if (!closed_list.contains(pre_id_pair.first, pre_id_pair.second)) {
       int pre_g = n_b->get_g() + get_adjusted_cost(op);
 
       open_list->set_goal(pre_state);
@@ -465,14 +450,8 @@ bool EagerSFBS::check_goal_and_set_plan(const GlobalState &state) {
 bool EagerSFBS::check_initial_and_set_plan(const GlobalState &state) {
   const GlobalState &initial_state =
       regression_state_registry.get_initial_state();
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
 
-  for (auto var : variables) {
-    if (state[var.get_id()] != var.get_domain_size() - 1 &&
-        state[var.get_id()] != initial_state[var.get_id()]) {
-      return false;
-    }
-  }
+  if (!regression_state_registry.subsumes(state, initial_state)) return false;
 
   Plan plan;
   partial_state_search_space.trace_path(state, plan);
@@ -486,14 +465,7 @@ bool EagerSFBS::check_initial_and_set_plan(const GlobalState &state) {
 
 bool EagerSFBS::check_meeting_and_set_plan(const GlobalState &s_f,
                                            const GlobalState &s_b) {
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
-
-  for (auto var : variables) {
-    if (s_b[var.get_id()] != var.get_domain_size() - 1 &&
-        s_f[var.get_id()] != s_b[var.get_id()]) {
-      return false;
-    }
-  }
+  if (!regression_state_registry.subsumes(s_b, s_f)) return false;
 
   Plan plan;
   partial_state_search_space.trace_path(s_f, plan);
@@ -511,5 +483,7 @@ bool EagerSFBS::check_meeting_and_set_plan(const GlobalState &s_f,
 void add_options_to_parser(OptionParser &parser) {
   SearchEngine::add_pruning_option(parser);
   SearchEngine::add_options_to_parser(parser);
+  regression_successor_generator::add_options_to_parser(parser);
+  fact_mutex_table::add_options_to_parser(parser);
 }
 }  // namespace eager_sfbs
@@ -0,0 +1,93 @@
+#include "fact_mutex_table.h"
+
+#include "h2_mutexes.h"
+
+#include "../option_parser.h"
+#include "../tasks/root_task.h"
+#include "../utils/timer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <set>
+
+using namespace std;
+
+namespace fact_mutex_table {
+FactMutexTable::FactMutexTable(double h2_time_limit)
+    : num_h2_mutex_pairs(0), h2_time(h2_time_limit) {
+  utils::Timer timer;
+  const AbstractTask &task = *tasks::g_root_task;
+  int num_variables = task.get_num_variables();
+
+  vector<vector<FactPair>> h2_mutexes;
+  bool use_h2 = h2_time_limit > 0.0 &&
+                h2_mutexes::compute_h2_mutexes(task, h2_time_limit, h2_mutexes);
+  has_h2_mutexes = use_h2;
+  if (use_h2) h2_time = timer();
+  int fact_id = 0;
+
+  domain_sizes.reserve(num_variables);
+  var_offsets.reserve(num_variables);
+  row_offsets.push_back(0);
+
+  for (int var = 0; var < num_variables; ++var) {
+    int domain_size = task.get_variable_domain_size(var);
+    domain_sizes.push_back(domain_size);
+    var_offsets.push_back(row_offsets.size() - 1);
+
+    for (int value = 0; value < domain_size; ++value) {
+      const set<FactPair> &fact_mutexes =
+          tasks::get_root_task_mutexes(FactPair(var, value));
+      size_t row_begin = mutexes.size();
+      mutexes.insert(mutexes.end(), fact_mutexes.begin(), fact_mutexes.end());
+
+      if (use_h2) {
+        for (const FactPair &fact : h2_mutexes[fact_id]) {
+          if (fact_mutexes.count(fact)) continue;
+          mutexes.push_back(fact);
+          ++num_h2_mutex_pairs;
+        }
+        sort(mutexes.begin() + row_begin, mutexes.end());
+      }
+
+      row_offsets.push_back(mutexes.size());
+      ++fact_id;
+    }
+  }
+
+  // Each pair was counted for both of its facts.
+  num_h2_mutex_pairs /= 2;
+  mutexes.shrink_to_fit();
+  cout << "Fact mutex table: " << get_num_mutex_pairs() << " mutex pairs";
+  if (use_h2) cout << " (" << num_h2_mutex_pairs << " found by h^2)";
+  cout << ", built in " << timer << endl;
+}
+
+bool FactMutexTable::has_same_mutexes_as(double h2_time_limit) const {
+  if (has_h2_mutexes)
+    return h2_time_limit > 0.0 && h2_time_limit >= h2_time;
+  else
+    return h2_time_limit <= h2_time;
+}
+
+const FactMutexTable &FactMutexTable::get_root_mutex_table(
+    double h2_time_limit) {
+  static vector<unique_ptr<FactMutexTable>> tables;
+  for (const unique_ptr<FactMutexTable> &table : tables)
+    if (table->has_same_mutexes_as(h2_time_limit)) return *table;
+
+  tables.emplace_back(new FactMutexTable(h2_time_limit));
+  return *tables.back();
+}
+
+void add_options_to_parser(options::OptionParser &parser) {
+  parser.add_option<double>(
+      "h2_mutex_time_limit",
+      "time limit in seconds for finding additional fact mutexes of the "
+      "regression with h^2 at startup (0 to disable); the mutexes are only "
+      "used if h^2 finishes in time",
+      "0", options::Bounds("0", "infinity"));
+}
+
+}  // namespace fact_mutex_table
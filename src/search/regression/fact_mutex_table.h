@@ -0,0 +1,89 @@
+#ifndef FACT_MUTEX_TABLE_H_
+#define FACT_MUTEX_TABLE_H_
+
+#include "../abstract_task.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace options {
+class OptionParser;
+}
+
+namespace fact_mutex_table {
+/*
+  The mutexes between facts of the root task, stored as one array of
+  facts with an offset for each fact (compressed sparse rows). They are
+  read from the mutex groups once, in time linear in the number of
+  mutex pairs, and shared by everything that regresses over the root
+  task. The facts mutex with a fact are ordered by variable and value,
+  and do not include the other values of its variable.
+
+  Tasks that add values to the root task, such as the unknown value of
+  partial states, can query their facts as well. The added values have
+  no mutexes.
+
+  With a positive h^2 time limit, the table also contains the mutexes
+  that h^2 finds within that limit. h^2 always finds the same mutexes
+  when it finishes, so a table is shared by all limits for which h^2
+  gives the same result: the limits at or above the time h^2 took, or
+  if it did not finish, the limits at or below the one it ran out of.
+*/
+class FactMutexTable {
+  std::vector<int> domain_sizes;
+  // The first row of each variable.
+  std::vector<int> var_offsets;
+  // The first mutex of each fact; row_offsets has one extra entry.
+  std::vector<int> row_offsets;
+  std::vector<FactPair> mutexes;
+  int num_h2_mutex_pairs;
+  bool has_h2_mutexes;
+  // The time h^2 took if it finished, the given limit otherwise.
+  double h2_time;
+
+  explicit FactMutexTable(double h2_time_limit);
+
+  bool has_same_mutexes_as(double h2_time_limit) const;
+
+ public:
+  class Range {
+    const FactPair *first;
+    const FactPair *last;
+
+   public:
+    Range(const FactPair *first, const FactPair *last)
+        : first(first), last(last) {}
+
+    const FactPair *begin() const { return first; }
+    const FactPair *end() const { return last; }
+    bool empty() const { return first == last; }
+  };
+
+  Range get_mutexes(int var, int value) const {
+    assert(var >= 0 && var < static_cast<int>(domain_sizes.size()));
+    if (value >= domain_sizes[var]) return Range(nullptr, nullptr);
+
+    int row = var_offsets[var] + value;
+    const FactPair *data = mutexes.data();
+    return Range(data + row_offsets[row], data + row_offsets[row + 1]);
+  }
+
+  // For facts of different variables.
+  bool are_mutex(const FactPair &fact1, const FactPair &fact2) const {
+    assert(fact1.var != fact2.var);
+    Range range = get_mutexes(fact1.var, fact1.value);
+    return std::binary_search(range.begin(), range.end(), fact2);
+  }
+
+  int get_num_mutex_pairs() const { return mutexes.size() / 2; }
+  int get_num_h2_mutex_pairs() const { return num_h2_mutex_pairs; }
+
+  // Build the table for the given h^2 time limit (0 disables h^2).
+  static const FactMutexTable &get_root_mutex_table(double h2_time_limit);
+};
+
+void add_options_to_parser(options::OptionParser &parser);
+}  // namespace fact_mutex_table
+
+#endif  // FACT_MUTEX_TABLE_H_
@@ -0,0 +1,196 @@
+#include "h2_mutexes.h"
+
+#include "../utils/countdown_timer.h"
+
+#include <cstddef>
+#include <iostream>
+
+using namespace std;
+
+namespace h2_mutexes {
+// Larger tasks would need more than 50 MB for the pair table.
+static const int MAX_FACTS = 20000;
+
+namespace {
+class H2Reachability {
+  struct Operator {
+    vector<int> preconditions;
+    vector<int> effects;
+    // Whether the operator changes a variable.
+    vector<bool> changes_var;
+  };
+
+  vector<int> fact_offsets;
+  vector<int> fact_vars;
+  int num_facts;
+  vector<Operator> operators;
+  vector<bool> fact_reached;
+  // pair_reached[f * num_facts + g]; pair_reached[f * num_facts + f]
+  // tells whether f is reached.
+  vector<bool> pair_reached;
+
+  bool is_reached(int f, int g) const {
+    return pair_reached[static_cast<size_t>(f) * num_facts + g];
+  }
+
+  bool reach(int f, int g) {
+    size_t index = static_cast<size_t>(f) * num_facts + g;
+    if (pair_reached[index]) return false;
+    pair_reached[index] = true;
+    pair_reached[static_cast<size_t>(g) * num_facts + f] = true;
+    return true;
+  }
+
+  bool is_applicable(const Operator &op) const {
+    for (size_t i = 0; i < op.preconditions.size(); ++i)
+      for (size_t j = i; j < op.preconditions.size(); ++j)
+        if (!is_reached(op.preconditions[i], op.preconditions[j])) return false;
+    return true;
+  }
+
+  bool apply(const Operator &op);
+
+ public:
+  explicit H2Reachability(const AbstractTask &task);
+
+  int get_num_facts() const { return num_facts; }
+
+  bool compute_fixpoint(utils::CountdownTimer &timer);
+  void get_mutexes(vector<vector<FactPair>> &mutexes) const;
+};
+
+H2Reachability::H2Reachability(const AbstractTask &task) : num_facts(0) {
+  int num_variables = task.get_num_variables();
+  for (int var = 0; var < num_variables; ++var) {
+    fact_offsets.push_back(num_facts);
+    num_facts += task.get_variable_domain_size(var);
+    fact_vars.resize(num_facts, var);
+  }
+
+  if (num_facts > MAX_FACTS) return;
+
+  for (int op_id = 0; op_id < task.get_num_operators(); ++op_id) {
+    Operator op;
+    op.changes_var.resize(num_variables, false);
+
+    for (int i = 0; i < task.get_num_operator_preconditions(op_id, false);
+         ++i) {
+      FactPair fact = task.get_operator_precondition(op_id, i, false);
+      op.preconditions.push_back(fact_offsets[fact.var] + fact.value);
+    }
+
+    for (int i = 0; i < task.get_num_operator_effects(op_id, false); ++i) {
+      FactPair fact = task.get_operator_effect(op_id, i, false);
+      op.effects.push_back(fact_offsets[fact.var] + fact.value);
+      op.changes_var[fact.var] = true;
+    }
+
+    operators.push_back(move(op));
+  }
+
+  pair_reached.assign(static_cast<size_t>(num_facts) * num_facts, false);
+  vector<int> initial_facts;
+  vector<int> initial_values = task.get_initial_state_values();
+  for (int var = 0; var < num_variables; ++var)
+    initial_facts.push_back(fact_offsets[var] + initial_values[var]);
+
+  for (int f : initial_facts)
+    for (int g : initial_facts) reach(f, g);
+}
+
+bool H2Reachability::apply(const Operator &op) {
+  bool changed = false;
+
+  for (size_t i = 0; i < op.effects.size(); ++i)
+    for (size_t j = i; j < op.effects.size(); ++j)
+      changed |= reach(op.effects[i], op.effects[j]);
+
+  // Facts that the operator does not change may hold along its effects.
+  for (int f = 0; f < num_facts; ++f) {
+    if (op.changes_var[fact_vars[f]] || !is_reached(f, f)) continue;
+
+    bool holds_with_preconditions = true;
+    for (int pre : op.preconditions) {
+      if (!is_reached(pre, f)) {
+        holds_with_preconditions = false;
+        break;
+      }
+    }
+
+    if (!holds_with_preconditions) continue;
+
+    for (int eff : op.effects) changed |= reach(eff, f);
+  }
+
+  return changed;
+}
+
+bool H2Reachability::compute_fixpoint(utils::CountdownTimer &timer) {
+  bool changed = true;
+
+  while (changed) {
+    changed = false;
+
+    for (const Operator &op : operators) {
+      if (timer.is_expired()) return false;
+      if (is_applicable(op)) changed |= apply(op);
+    }
+  }
+
+  return true;
+}
+
+void H2Reachability::get_mutexes(vector<vector<FactPair>> &mutexes) const {
+  mutexes.assign(num_facts, vector<FactPair>());
+
+  for (int f = 0; f < num_facts; ++f) {
+    if (!is_reached(f, f)) continue;
+
+    for (int g = 0; g < num_facts; ++g) {
+      if (fact_vars[g] == fact_vars[f] || !is_reached(g, g) || is_reached(f, g))
+        continue;
+
+      mutexes[f].emplace_back(fact_vars[g], g - fact_offsets[fact_vars[g]]);
+    }
+  }
+}
+}  // namespace
+
+bool compute_h2_mutexes(const AbstractTask &task, double time_limit,
+                        vector<vector<FactPair>> &mutexes) {
+  mutexes.clear();
+
+  if (task.get_num_axioms() > 0) {
+    cout << "h^2 mutexes are not computed for tasks with axioms" << endl;
+    return false;
+  }
+
+  for (int op_id = 0; op_id < task.get_num_operators(); ++op_id) {
+    for (int i = 0; i < task.get_num_operator_effects(op_id, false); ++i) {
+      if (task.get_num_operator_effect_conditions(op_id, i, false) > 0) {
+        cout << "h^2 mutexes are not computed for tasks with conditional "
+             << "effects" << endl;
+        return false;
+      }
+    }
+  }
+
+  utils::CountdownTimer timer(time_limit);
+  H2Reachability reachability(task);
+
+  if (reachability.get_num_facts() > MAX_FACTS) {
+    cout << "h^2 mutexes are not computed for more than " << MAX_FACTS
+         << " facts" << endl;
+    return false;
+  }
+
+  if (!reachability.compute_fixpoint(timer)) {
+    cout << "h^2 mutexes are not computed within " << time_limit << "s"
+         << endl;
+    return false;
+  }
+
+  reachability.get_mutexes(mutexes);
+  return true;
+}
+}  // namespace h2_mutexes
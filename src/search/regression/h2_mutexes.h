@@ -0,0 +1,29 @@
+#ifndef H2_MUTEXES_H_
+#define H2_MUTEXES_H_
+
+#include "../abstract_task.h"
+
+#include <vector>
+
+namespace h2_mutexes {
+/*
+  Find the pairs of facts that h^2 proves unreachable from the initial
+  state of task, i.e., mutexes that the translator may have missed. The
+  reachable pairs are computed as a fixpoint over the operators, in
+  which a pair is reachable if an operator adds both facts, or adds one
+  and is applicable together with the other one, which it does not
+  change.
+
+  On success, mutexes[f] holds the facts on other variables that are
+  mutex with the fact with id f, where fact ids are assigned variable
+  by variable, and the result is true. Facts that are not reachable at
+  all have no mutexes. Only a complete fixpoint proves mutexes, so the
+  result is false and mutexes is empty if the time limit expires, the
+  pair table would be too large, or the task has axioms or conditional
+  effects.
+*/
+bool compute_h2_mutexes(const AbstractTask &task, double time_limit,
+                        std::vector<std::vector<FactPair>> &mutexes);
+}  // namespace h2_mutexes
+
+#endif  // H2_MUTEXES_H_
@@ -10,6 +10,7 @@
 #include "../front_to_front/front_to_front_open_list_factory.h"
 #include "../task_utils/successor_generator.h"
 #include "../task_utils/task_properties.h"
+#include "fact_mutex_table.h"
 #include "regression_successor_generator.h"
 
 #include <cassert>
@@ -34,13 +35,20 @@ LazySFBS::LazySFBS(const Options &opts)
           opts.get_list<shared_ptr<FrontToFrontHeuristic>>("preferred")),
       directions(NONE),
       state_operator_id(OperatorID::no_operator),
-      partial_state_task(tasks::PartialStateTask::get_partial_state_task()),
+      partial_state_task(tasks::PartialStateTask::get_partial_state_task(
+          opts.get<double>("h2_mutex_time_limit"))),
       partial_state_task_proxy(*partial_state_task),
-      regression_state_registry(partial_state_task_proxy),
+      regression_state_registry(
+          partial_state_task_proxy,
+          fact_mutex_table::FactMutexTable::get_root_mutex_table(
+              opts.get<double>("h2_mutex_time_limit"))),
       partial_state_search_space(regression_state_registry),
-      regression_task(tasks::RegressionTask::get_regression_task()),
+      regression_task(tasks::RegressionTask::get_regression_task(
+          opts.get<double>("h2_mutex_time_limit"))),
       regression_task_proxy(*regression_task),
-      regression_successor_generator(regression_task),
+      regression_successor_generator(
+          regression_task, opts.get<bool>("flat_successor_generator"),
+          opts.get<bool>("achiever_index")),
       for_current_state(regression_state_registry.get_initial_state()),
       bac_current_state(regression_state_registry.create_goal_state(
           partial_state_task_proxy.create_state(
@@ -122,9 +130,7 @@ SearchStatus LazySFBS::fetch_next_state() {
 
     auto id_pair = make_pair(for_id.get_value(), bac_id.get_value());
 
-    if (closed_list.find(id_pair) != closed_list.end()) continue;
-
-    closed_list.insert(id_pair);
+    if (!closed_list.insert(id_pair.first, id_pair.second)) continue;
 
     open_list->set_goal(bac_current_state);
 
@@ -165,7 +171,8 @@ SearchStatus LazySFBS::fetch_next_state() {
     }
 
     current_eval_context =
-        EvaluationContext(for_current_state, current_g, true, &statistics);
+        EvaluationContext(for_current_state, current_g, true, &statistics,
+                          !preferred_operator_evaluators.empty());
     statistics.inc_evaluated_states();
     if (open_list->is_dead_end(current_eval_context)) continue;
 
@@ -223,7 +230,7 @@ SearchStatus LazySFBS::for_step() {
                                   bac_current_state.get_id().get_value());
     int succ_g = current_g + get_adjusted_cost(op);
 
-    if (closed_list.find(succ_id_pair) == closed_list.end()) {
+    if (!closed_list.contains(succ_id_pair.first, succ_id_pair.second)) {
       n_steps[succ_state] = n_steps[for_current_state] + 1;
       bool is_preferred = preferred_operators.contains(op_id);
       EvaluationContext succ_eval_context(current_eval_context.get_cache(),
@@ -261,8 +268,8 @@ SearchStatus LazySFBS::for_step() {
 SearchStatus LazySFBS::bac_step() {
   statistics.inc_expanded();
   vector<OperatorID> applicable_ops;
-  regression_successor_generator.generate_applicable_ops(bac_current_state,
-                                                         applicable_ops);
+  regression_successor_generator.generate_relevant_ops(bac_current_state,
+                                                       applicable_ops);
 
   ordered_set::OrderedSet<OperatorID> preferred_operators;
 
@@ -279,19 +286,6 @@ SearchStatus LazySFBS::bac_step() {
     OperatorProxy op = regression_task_proxy.get_operators()[op_id];
     if ((current_g + op.get_cost()) >= bound) continue;
 
-    OperatorProxy forward_op = task_proxy.get_operators()[op_id];
-    bool any = false;
-
-    for (EffectProxy effect : forward_op.get_effects()) {
-      FactPair effect_pair = effect.get_fact().get_pair();
-      if (bac_current_state[effect_pair.var] == effect_pair.value) {
-        any = true;
-        break;
-      }
-    }
-
-    if (!any) continue;
-
     StateID succ_id =
         regression_state_registry.get_predecessor_state(bac_current_state, op);
 
@@ -318,7 +312,7 @@ SearchStatus LazySFBS::bac_step() {
                                   succ_state.get_id().get_value());
     int succ_g = current_g + get_adjusted_cost(op);
 
-    if (closed_list.find(succ_id_pair) == closed_list.end()) {
+    if (!closed_list.contains(succ_id_pair.first, succ_id_pair.second)) {
       n_steps[succ_state] = n_steps[bac_current_state] + 1;
       bool is_preferred = preferred_operators.contains(op_id);
       EvaluationContext succ_eval_context(current_eval_context.get_cache(),
@@ -385,14 +379,8 @@ bool LazySFBS::check_goal_and_set_plan(const GlobalState &state) {
 bool LazySFBS::check_initial_and_set_plan(const GlobalState &state) {
   const GlobalState &initial_state =
       regression_state_registry.get_initial_state();
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
 
-  for (auto var : variables) {
-    if (state[var.get_id()] != var.get_domain_size() - 1 &&
-        state[var.get_id()] != initial_state[var.get_id()]) {
-      return false;
-    }
-  }
+  if (!regression_state_registry.subsumes(state, initial_state)) return false;
 
   Plan plan;
   partial_state_search_space.trace_path(state, plan);
@@ -406,14 +394,7 @@ bool LazySFBS::check_initial_and_set_plan(const GlobalState &state) {
 
 bool LazySFBS::check_meeting_and_set_plan(const GlobalState &s_f,
                                           const GlobalState &s_b) {
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
-
-  for (auto var : variables) {
-    if (s_b[var.get_id()] != var.get_domain_size() - 1 &&
-        s_f[var.get_id()] != s_b[var.get_id()]) {
-      return false;
-    }
-  }
+  if (!regression_state_registry.subsumes(s_b, s_f)) return false;
 
   Plan plan;
   partial_state_search_space.trace_path(s_f, plan);
@@ -431,6 +412,9 @@ bool LazySFBS::check_meeting_and_set_plan(const GlobalState &s_f,
 void LazySFBS::print_statistics() const {
   statistics.print_detailed_statistics();
   partial_state_search_space.print_statistics();
+  regression_state_registry.print_statistics();
+  closed_list.print_statistics("Closed frontier pairs");
+  open_list->print_statistics();
 }
 
 void LazySFBS::reward_progress() { open_list->boost_preferred(); }
@@ -438,5 +422,7 @@ void LazySFBS::reward_progress() { open_list->boost_preferred(); }
 void add_options_to_parser(OptionParser &parser) {
   SearchEngine::add_pruning_option(parser);
   SearchEngine::add_options_to_parser(parser);
+  regression_successor_generator::add_options_to_parser(parser);
+  fact_mutex_table::add_options_to_parser(parser);
 }
 }  // namespace lazy_sfbs
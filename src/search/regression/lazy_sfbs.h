@@ -1,6 +1,7 @@
 #ifndef LAZY_SFBS_H
 #define LAZY_SFBS_H
 
+#include "../algorithms/pair_hash_set.h"
 #include "../bidirectional/bidirectional_search.h"
 #include "../front_to_front/front_to_front_heuristic.h"
 #include "../front_to_front/front_to_front_open_list.h"
@@ -23,12 +24,6 @@ namespace lazy_sfbs {
 class LazySFBS : public SearchEngine {
   enum Direction { NONE = 0, FORWARD = 1, BACKWARD = 2 };
 
-  struct FrontierHash {
-    std::size_t operator()(const std::pair<int, int> &entry) const {
-      return std::hash<int>()(entry.first) ^ std::hash<int>()(entry.second);
-    }
-  };
-
   const bool reopen_closed_nodes;
   bool preferred_successors_first;
   bool is_initial;
@@ -41,7 +36,8 @@ class LazySFBS : public SearchEngine {
   std::vector<std::shared_ptr<FrontToFrontHeuristic>>
       preferred_operator_evaluators;
 
-  std::unordered_set<std::pair<int, int>, FrontierHash> closed_list;
+  // Closed frontier pairs of forward and backward state IDs.
+  pair_hash_set::PairHashSet closed_list;
   PerStateInformation<Direction> directions;
   PerStateInformation<OperatorID> state_operator_id;
 
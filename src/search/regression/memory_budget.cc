@@ -0,0 +1,82 @@
+#include "memory_budget.h"
+
+#include "../option_parser.h"
+#include "../utils/system.h"
+
+#include <iostream>
+
+using namespace std;
+
+namespace memory_budget {
+// Fractions of the budget at which the levels are entered.
+static const double LEVEL_THRESHOLDS[] = {0.0, 0.6, 0.75, 0.9};
+
+const char *get_level_name(Level level) {
+  switch (level) {
+    case Level::NORMAL:
+      return "normal";
+    case Level::NO_BDDS:
+      return "no closed BDDs";
+    case Level::PRUNED_BACKWARD:
+      return "pruned backward open list";
+    case Level::FORWARD_ONLY:
+      return "forward search only";
+  }
+  return "unknown";
+}
+
+MemoryBudget::MemoryBudget(const options::Options &opts)
+    : budget_in_kb(opts.get<int>("memory_budget") * 1024),
+      check_interval(opts.get<int>("memory_check_interval")),
+      backward_open_limit(opts.get<int>("backward_open_limit")),
+      calls_until_check(0),
+      peak_memory_in_kb(0),
+      num_checks(0),
+      level(Level::NORMAL) {}
+
+Level MemoryBudget::check() {
+  if (!is_enabled() || level == Level::FORWARD_ONLY) return level;
+  if (--calls_until_check > 0) return level;
+
+  calls_until_check = check_interval;
+  peak_memory_in_kb = utils::get_peak_memory_in_kb();
+  ++num_checks;
+
+  Level required = level;
+  for (int i = static_cast<int>(level) + 1;
+       i <= static_cast<int>(Level::FORWARD_ONLY); ++i) {
+    if (peak_memory_in_kb >= LEVEL_THRESHOLDS[i] * budget_in_kb)
+      required = Level(i);
+  }
+
+  return required;
+}
+
+void MemoryBudget::enter(Level new_level) {
+  if (new_level > level) level = new_level;
+}
+
+void MemoryBudget::print_statistics() const {
+  cout << "Memory budget: " << budget_in_kb << " KB" << endl;
+  cout << "Memory budget checks: " << num_checks << " (last peak memory "
+       << peak_memory_in_kb << " KB)" << endl;
+  cout << "Memory budget level: " << get_level_name(level) << endl;
+}
+
+void add_options_to_parser(options::OptionParser &parser) {
+  parser.add_option<int>(
+      "memory_budget",
+      "memory budget in MB; as the peak memory approaches it, the search "
+      "drops its closed BDDs, prunes the backward open list and finally "
+      "only searches forward (0 disables it)",
+      "0", options::Bounds("0", "infinity"));
+  parser.add_option<int>("memory_check_interval",
+                         "number of search steps between two checks of the "
+                         "memory budget",
+                         "100", options::Bounds("1", "infinity"));
+  parser.add_option<int>("backward_open_limit",
+                         "number of best backward open states kept when the "
+                         "memory budget prunes the backward open list",
+                         "1000", options::Bounds("1", "infinity"));
+}
+}  // namespace memory_budget
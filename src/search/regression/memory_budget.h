@@ -0,0 +1,60 @@
+#ifndef MEMORY_BUDGET_H_
+#define MEMORY_BUDGET_H_
+
+namespace options {
+class OptionParser;
+class Options;
+}  // namespace options
+
+namespace memory_budget {
+/*
+  Levels of a search that degrades as it runs out of memory, in the
+  order in which they are entered. Each level keeps the measures of the
+  previous ones.
+*/
+enum class Level { NORMAL, NO_BDDS, PRUNED_BACKWARD, FORWARD_ONLY };
+
+const char *get_level_name(Level level);
+
+/*
+  Maps the peak memory of the process to a degradation level: the
+  closed BDDs are dropped at 60% of the budget, the backward open list
+  is pruned at 75% and only the forward search continues from 90% on.
+  The peak memory is what the memory limit of the planner applies to.
+  It never decreases, and neither does the level.
+*/
+class MemoryBudget {
+  int budget_in_kb;
+  int check_interval;
+  int backward_open_limit;
+  int calls_until_check;
+  int peak_memory_in_kb;
+  int num_checks;
+  Level level;
+
+ public:
+  explicit MemoryBudget(const options::Options &opts);
+
+  bool is_enabled() const { return budget_in_kb > 0; }
+
+  /*
+    Probe the peak memory every check_interval calls and return the
+    level that it calls for, which is never below the current level.
+  */
+  Level check();
+
+  // Record that the search has degraded to level.
+  void enter(Level new_level);
+
+  Level get_level() const { return level; }
+  int get_budget_in_kb() const { return budget_in_kb; }
+  int get_peak_memory_in_kb() const { return peak_memory_in_kb; }
+  int get_backward_open_limit() const { return backward_open_limit; }
+
+  void print_statistics() const;
+};
+
+void add_options_to_parser(options::OptionParser &parser);
+}  // namespace memory_budget
+
+#endif  // MEMORY_BUDGET_H_
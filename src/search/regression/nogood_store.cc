@@ -0,0 +1,43 @@
+#include "nogood_store.h"
+
+#include "../option_parser.h"
+
+#include <iostream>
+
+using namespace std;
+
+namespace nogood_store {
+NogoodStore::NogoodStore(const TaskProxy &task_proxy)
+    : nogoods(task_proxy),
+      num_checks(0),
+      num_applied(0),
+      num_evaluations_saved(0) {}
+
+void NogoodStore::learn(const GlobalState &state) {
+  // A nogood that is subsumed by a stored one adds nothing.
+  if (nogoods.find_subsuming_state(state) == StateID::no_state)
+    nogoods.insert(state);
+}
+
+bool NogoodStore::is_doomed(const GlobalState &state) {
+  ++num_checks;
+  bool doomed = has_nogood(state);
+  if (doomed) ++num_applied;
+  return doomed;
+}
+
+void NogoodStore::print_statistics() const {
+  cout << "Nogoods learned: " << nogoods.size() << endl;
+  cout << "Nogood checks: " << num_checks << endl;
+  cout << "Nogoods applied: " << num_applied << endl;
+  cout << "Evaluations saved by nogoods: " << num_evaluations_saved << endl;
+}
+
+void add_options_to_parser(options::OptionParser &parser) {
+  parser.add_option<bool>(
+      "nogoods",
+      "prune backward states that define all facts of a partial state "
+      "found unreachable from the initial state by a reliable dead end",
+      "false");
+}
+}  // namespace nogood_store
@@ -0,0 +1,54 @@
+#ifndef NOGOOD_STORE_H_
+#define NOGOOD_STORE_H_
+
+#include "../global_state.h"
+#include "../task_proxy.h"
+#include "partial_state_index.h"
+
+namespace options {
+class OptionParser;
+}
+
+namespace nogood_store {
+/*
+  Partial states that are unreachable from the initial state. They are
+  learned from reliable dead ends of evaluations that start in the
+  initial state: no state reachable from it satisfies the dead end.
+
+  A partial state is doomed if it defines all facts of a nogood, since
+  it is unreachable as well. Backward states that are doomed can be
+  pruned without evaluating them, and they are no targets for forward
+  states, which are all reachable.
+*/
+class NogoodStore {
+  partial_state_index::PartialStateIndex nogoods;
+
+  long long num_checks;
+  long long num_applied;
+  long long num_evaluations_saved;
+
+ public:
+  explicit NogoodStore(const TaskProxy &task_proxy);
+
+  void learn(const GlobalState &state);
+
+  // Whether state defines all facts of a learned nogood.
+  bool is_doomed(const GlobalState &state);
+
+  // Like is_doomed, but not counted in the statistics.
+  bool has_nogood(const GlobalState &state) const {
+    return nogoods.size() != 0 &&
+           nogoods.find_subsuming_state(state) != StateID::no_state;
+  }
+
+  void count_saved_evaluations(int num_evaluations) {
+    num_evaluations_saved += num_evaluations;
+  }
+
+  void print_statistics() const;
+};
+
+void add_options_to_parser(options::OptionParser &parser);
+}  // namespace nogood_store
+
+#endif  // NOGOOD_STORE_H_
@@ -0,0 +1,123 @@
+#include "partial_state_index.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace partial_state_index {
+PartialStateIndex::PartialStateIndex(const TaskProxy &task_proxy)
+    : nodes(1), num_states(0) {
+  VariablesProxy variables = task_proxy.get_variables();
+  fact_offsets.reserve(variables.size());
+  unknown_values.reserve(variables.size());
+  int offset = 0;
+
+  for (auto var : variables) {
+    fact_offsets.push_back(offset);
+    unknown_values.push_back(var.get_domain_size() - 1);
+    offset += var.get_domain_size();
+    fact_to_var.resize(offset, var.get_id());
+  }
+}
+
+void PartialStateIndex::get_defined_facts(const GlobalState &state,
+                                          vector<int> &facts) const {
+  for (int var = 0, n = fact_offsets.size(); var < n; ++var) {
+    int value = state[var];
+    if (value != unknown_values[var]) facts.push_back(fact_offsets[var] + value);
+  }
+}
+
+void PartialStateIndex::insert(const GlobalState &state) {
+  vector<int> facts;
+  get_defined_facts(state, facts);
+  int node_id = 0;
+
+  for (int fact : facts) {
+    auto &children = nodes[node_id].children;
+    auto it = lower_bound(children.begin(), children.end(),
+                          make_pair(fact, -1));
+
+    if (it != children.end() && it->first == fact) {
+      node_id = it->second;
+    } else {
+      int child_id = nodes.size();
+      children.insert(it, make_pair(fact, child_id));
+      nodes.emplace_back();
+      node_id = child_id;
+    }
+  }
+
+  if (nodes[node_id].state_id == StateID::no_state) {
+    nodes[node_id].state_id = state.get_id();
+    ++num_states;
+  }
+}
+
+StateID PartialStateIndex::get_any_state(int node_id) const {
+  while (nodes[node_id].state_id == StateID::no_state) {
+    // Every leaf stores a state, so descending always finds one.
+    assert(!nodes[node_id].children.empty());
+    node_id = nodes[node_id].children.front().second;
+  }
+
+  return nodes[node_id].state_id;
+}
+
+StateID PartialStateIndex::find_subsuming_state(
+    const GlobalState &state, int node_id, const StateFilter *accept) const {
+  const Node &node = nodes[node_id];
+  if (node.state_id != StateID::no_state &&
+      (!accept || (*accept)(node.state_id)))
+    return node.state_id;
+
+  for (const auto &child : node.children) {
+    int var = fact_to_var[child.first];
+    if (state[var] != child.first - fact_offsets[var]) continue;
+    StateID result = find_subsuming_state(state, child.second, accept);
+    if (result != StateID::no_state) return result;
+  }
+
+  return StateID::no_state;
+}
+
+StateID PartialStateIndex::find_subsuming_state(
+    const GlobalState &state) const {
+  return find_subsuming_state(state, 0, nullptr);
+}
+
+StateID PartialStateIndex::find_subsuming_state(
+    const GlobalState &state, const StateFilter &accept) const {
+  return find_subsuming_state(state, 0, &accept);
+}
+
+StateID PartialStateIndex::find_subsumed_state(const vector<int> &facts,
+                                               int pos, int node_id) const {
+  if (pos == static_cast<int>(facts.size())) return get_any_state(node_id);
+
+  int fact = facts[pos];
+
+  for (const auto &child : nodes[node_id].children) {
+    /*
+      Children are sorted by fact id. A stored state that skips the
+      current query fact cannot contain it anymore.
+    */
+    if (child.first > fact) break;
+    if (child.first != fact && fact_to_var[child.first] == fact_to_var[fact])
+      continue;
+    int next_pos = child.first == fact ? pos + 1 : pos;
+    StateID result = find_subsumed_state(facts, next_pos, child.second);
+    if (result != StateID::no_state) return result;
+  }
+
+  return StateID::no_state;
+}
+
+StateID PartialStateIndex::find_subsumed_state(const GlobalState &state) const {
+  vector<int> facts;
+  get_defined_facts(state, facts);
+
+  return find_subsumed_state(facts, 0, 0);
+}
+}  // namespace partial_state_index
@@ -0,0 +1,74 @@
+#ifndef PARTIAL_STATE_INDEX_H
+#define PARTIAL_STATE_INDEX_H
+
+#include "../global_state.h"
+#include "../state_id.h"
+#include "../task_proxy.h"
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+/*
+  Subsumption index over registered (partial) states.
+
+  Each state is stored as the sorted sequence of its defined facts in a
+  fact-keyed trie (an UBTree). A variable is undefined if it has the
+  extra "unknown" value domain_size - 1 of the partial state task. Since
+  fact ids are assigned variable by variable, the facts of a state are
+  sorted by variable as well.
+
+  The index answers two queries without scanning all stored states:
+
+  find_subsuming_state(s): a stored state whose defined facts all hold
+    in s, e.g., a backward state that a forward state satisfies.
+
+  find_subsumed_state(s): a stored state that satisfies all defined
+    facts of s, e.g., a forward state that satisfies a backward state.
+
+  find_subsuming_state also takes a filter, so that it only returns
+  states for which the filter holds, e.g., states with a lower g.
+
+  States are inserted incrementally and never removed.
+*/
+namespace partial_state_index {
+class PartialStateIndex {
+  struct Node {
+    // (fact id, node index) sorted by fact id.
+    std::vector<std::pair<int, int>> children;
+    StateID state_id;
+  };
+
+  std::vector<int> fact_offsets;
+  std::vector<int> fact_to_var;
+  std::vector<int> unknown_values;
+  std::vector<Node> nodes;
+  int num_states;
+
+  void get_defined_facts(const GlobalState &state,
+                         std::vector<int> &facts) const;
+
+  using StateFilter = std::function<bool(StateID)>;
+
+  StateID find_subsuming_state(const GlobalState &state, int node_id,
+                               const StateFilter *accept) const;
+  StateID find_subsumed_state(const std::vector<int> &facts, int pos,
+                              int node_id) const;
+  StateID get_any_state(int node_id) const;
+
+ public:
+  explicit PartialStateIndex(const TaskProxy &task_proxy);
+
+  void insert(const GlobalState &state);
+
+  StateID find_subsuming_state(const GlobalState &state) const;
+  StateID find_subsuming_state(const GlobalState &state,
+                               const StateFilter &accept) const;
+  StateID find_subsumed_state(const GlobalState &state) const;
+
+  int size() const { return num_states; }
+  int get_num_nodes() const { return nodes.size(); }
+};
+}  // namespace partial_state_index
+
+#endif
@@ -1,5 +1,7 @@
 #include "partial_state_task.h"
 
+#include "fact_mutex_table.h"
+
 #include "../landmarks/exploration.h"
 #include "../option_parser.h"
 #include "../plugin.h"
@@ -15,8 +17,16 @@ using namespace std;
 
 namespace tasks {
 
-PartialStateTask::PartialStateTask(const shared_ptr<AbstractTask> &parent)
-    : parent(parent) {}
+PartialStateTask::PartialStateTask(const shared_ptr<AbstractTask> &parent,
+                                   double h2_time_limit)
+    : parent(parent),
+      mutex_table(fact_mutex_table::FactMutexTable::get_root_mutex_table(
+          h2_time_limit)) {}
+
+bool PartialStateTask::has_same_parent(const AbstractTask *task) const {
+  const PartialStateTask *other = dynamic_cast<const PartialStateTask *>(task);
+  return other && other->parent == parent;
+}
 
 vector<int> PartialStateTask::get_goal_state_values() const {
   vector<int> values(get_num_variables());
@@ -60,7 +70,9 @@ string PartialStateTask::get_fact_name(const FactPair &fact) const {
 
 bool PartialStateTask::are_facts_mutex(const FactPair &fact1,
                                        const FactPair &fact2) const {
-  return parent->are_facts_mutex(fact1, fact2);
+  if (fact1.var == fact2.var) return parent->are_facts_mutex(fact1, fact2);
+
+  return mutex_table.are_mutex(fact1, fact2);
 }
 
 int PartialStateTask::get_operator_cost(int index, bool is_axiom) const {
@@ -113,7 +125,7 @@ FactPair PartialStateTask::get_operator_effect(int op_index, int eff_index,
 
 int PartialStateTask::convert_operator_index(
     int index, const AbstractTask *ancestor_task) const {
-  if (ancestor_task == this) {
+  if (ancestor_task == this || has_same_parent(ancestor_task)) {
     return index;
   }
   return parent->convert_operator_index(index, ancestor_task);
@@ -135,7 +147,7 @@ vector<int> PartialStateTask::get_initial_state_values() const {
 
 void PartialStateTask::convert_state_values(
     vector<int> &values, const AbstractTask *ancestor_task) const {
-  if (this == ancestor_task) {
+  if (this == ancestor_task || has_same_parent(ancestor_task)) {
     return;
   }
   parent->convert_state_values(values, ancestor_task);
@@ -143,12 +155,14 @@ void PartialStateTask::convert_state_values(
 }
 
 static shared_ptr<AbstractTask> _parse(OptionParser &parser) {
+  fact_mutex_table::add_options_to_parser(parser);
   Options opts = parser.parse();
 
   if (parser.dry_run())
     return nullptr;
   else
-    return PartialStateTask::get_partial_state_task();
+    return PartialStateTask::get_partial_state_task(
+        opts.get<double>("h2_mutex_time_limit"));
 }
 
 static Plugin<AbstractTask> _plugin("partial_state", _parse);
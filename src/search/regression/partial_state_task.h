@@ -1,6 +1,7 @@
 #ifndef PARTIAL_STATE_TASK_H
 #define PARTIAL_STATE_TASK_H
 
+#include <map>
 #include <memory>
 #include <stack>
 #include <string>
@@ -13,6 +14,10 @@
 
 using namespace std;
 
+namespace fact_mutex_table {
+class FactMutexTable;
+}
+
 namespace options {
 class OptionParser;
 }
@@ -22,9 +27,17 @@ namespace tasks {
 class PartialStateTask : public AbstractTask {
  protected:
   const std::shared_ptr<AbstractTask> parent;
+  const fact_mutex_table::FactMutexTable &mutex_table;
+
+  /*
+    Partial state tasks of the same parent only differ in their mutexes,
+    so their states and operators can be used interchangeably.
+  */
+  bool has_same_parent(const AbstractTask *task) const;
 
  public:
-  PartialStateTask(const std::shared_ptr<AbstractTask> &parent);
+  PartialStateTask(const std::shared_ptr<AbstractTask> &parent,
+                   double h2_time_limit);
   virtual ~PartialStateTask() override = default;
 
   std::vector<int> get_goal_state_values() const;
@@ -70,9 +83,12 @@ class PartialStateTask : public AbstractTask {
       const AbstractTask *ancestor_task) const final override;
   virtual void convert_state_values_from_parent(std::vector<int> &) const {}
 
-  static std::shared_ptr<AbstractTask> get_partial_state_task() {
-    static std::shared_ptr<AbstractTask> task =
-        std::make_shared<PartialStateTask>(g_root_task);
+  static std::shared_ptr<AbstractTask> get_partial_state_task(
+      double h2_time_limit) {
+    static std::map<double, std::shared_ptr<AbstractTask>> tasks;
+    std::shared_ptr<AbstractTask> &task = tasks[h2_time_limit];
+    if (!task)
+      task = std::make_shared<PartialStateTask>(g_root_task, h2_time_limit);
 
     return task;
   }
@@ -4,6 +4,8 @@
 #include "../plugin.h"
 #include "../search_engines/search_common.h"
 #include "bidirectional_eager_search.h"
+#include "fact_mutex_table.h"
+#include "symbolic_closed.h"
 
 using namespace std;
 
@@ -18,7 +20,14 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
       "open_b", "backward open list");
   parser.add_option<bool>("reopen_closed", "reopen closed nodes", "false");
   parser.add_option<bool>("bdd", "use BDD for duplicate detection", "false");
+  symbolic_closed::add_options_to_parser(parser);
   parser.add_option<int>("max_steps", "max steps for one direction", "0");
+  parser.add_option<bool>(
+      "concurrent",
+      "expand a forward and a backward state in each step and evaluate their "
+      "successors in parallel (the forward and backward open lists must not "
+      "share heuristics)",
+      "false");
   parser.add_option<shared_ptr<Evaluator>>(
       "f_eval_f",
       "set forward evaluator for jump statistics. "
@@ -64,6 +73,16 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
   reeval_docs.push_back("Reeval all nodes");
   parser.add_enum_option("reeval", reeval_names, "Reevaluation method", "NO",
                          reeval_docs);
+  parser.add_option<int>(
+      "reeval_threads",
+      "number of threads evaluating the open list with reeval=ALL; "
+      "the search does not depend on it",
+      "1", Bounds("1", "infinity"));
+  parser.add_option<int>(
+      "eval_threads",
+      "number of threads evaluating the successors of each expansion; "
+      "the search does not depend on it",
+      "1", Bounds("1", "infinity"));
 
   bidirectional_eager_search::add_options_to_parser(parser);
   Options opts = parser.parse();
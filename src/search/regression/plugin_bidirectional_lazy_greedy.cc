@@ -1,5 +1,7 @@
 #include "../search_engines/search_common.h"
 #include "bidirectional_lazy_search.h"
+#include "fact_mutex_table.h"
+#include "symbolic_closed.h"
 
 #include "../front_to_front/front_to_front_open_list_factory.h"
 #include "../option_parser.h"
@@ -19,6 +21,7 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
   parser.add_option<bool>(
       "prune_goal", "prune goal state other than the original goal", "false");
   parser.add_option<bool>("bdd", "use BDD for duplicate detection", "false");
+  symbolic_closed::add_options_to_parser(parser);
   parser.add_option<bool>("reeval", "do re evaluation", "false");
   parser.add_option<bool>("front_to_front", "f2f", "false");
   parser.add_option<bool>("use_bgg", "use BGGs", "false");
@@ -45,6 +48,8 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
 
   SearchEngine::add_succ_order_options(parser);
   SearchEngine::add_options_to_parser(parser);
+  regression_successor_generator::add_options_to_parser(parser);
+  fact_mutex_table::add_options_to_parser(parser);
   Options opts = parser.parse();
 
   shared_ptr<bidirectional_lazy_search::BidirectionalLazySearch> engine;
@@ -1,5 +1,6 @@
 #include "../search_engines/search_common.h"
 #include "eager_sfbs.h"
+#include "fact_mutex_table.h"
 
 #include "../front_to_front/front_to_front_open_list_factory.h"
 #include "../option_parser.h"
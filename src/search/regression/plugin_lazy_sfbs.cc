@@ -1,4 +1,5 @@
 #include "../search_engines/search_common.h"
+#include "fact_mutex_table.h"
 #include "lazy_sfbs.h"
 
 #include "../front_to_front/front_to_front_open_list_factory.h"
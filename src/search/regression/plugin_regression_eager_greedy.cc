@@ -1,5 +1,7 @@
 #include "../search_engines/search_common.h"
+#include "fact_mutex_table.h"
 #include "regression_eager_search.h"
+#include "symbolic_closed.h"
 
 #include "../front_to_front/front_to_front_open_list_factory.h"
 #include "../option_parser.h"
@@ -31,6 +33,7 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
   parser.add_option<bool>(
       "prune_goal", "prune goal state other than the original goal", "false");
   parser.add_option<bool>("bdd", "use BDD", "false");
+  symbolic_closed::add_options_to_parser(parser);
 
   regression_eager_search::add_options_to_parser(parser);
   Options opts = parser.parse();
@@ -1,6 +1,8 @@
 #include "../front_to_front/front_to_front_open_list_factory.h"
 #include "../search_engines/search_common.h"
+#include "fact_mutex_table.h"
 #include "regression_lazy_search.h"
+#include "symbolic_closed.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
@@ -16,10 +18,14 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
   parser.add_option<bool>(
       "prune_goal", "prune goal state other than the original goal", "false");
   parser.add_option<bool>("bdd", "use BDD for duplicate detection", "false");
+  symbolic_closed::add_options_to_parser(parser);
   parser.add_list_option<shared_ptr<FrontToFrontHeuristic>>(
       "preferred", "use preferred operators of these evaluators", "[]");
   SearchEngine::add_succ_order_options(parser);
   SearchEngine::add_options_to_parser(parser);
+  regression_successor_generator::add_options_to_parser(parser);
+  fact_mutex_table::add_options_to_parser(parser);
+  subsumption_pruning::add_options_to_parser(parser);
   Options opts = parser.parse();
 
   shared_ptr<regression_lazy_search::RegressionLazySearch> engine;
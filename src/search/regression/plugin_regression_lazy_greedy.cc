@@ -1,4 +1,5 @@
 #include "../search_engines/search_common.h"
+#include "fact_mutex_table.h"
 #include "regression_lazy_search.h"
 
 #include "../option_parser.h"
@@ -64,6 +65,9 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
       "prune_goal", "prune goal state other than the original goal", "false");
   SearchEngine::add_succ_order_options(parser);
   SearchEngine::add_options_to_parser(parser);
+  regression_successor_generator::add_options_to_parser(parser);
+  fact_mutex_table::add_options_to_parser(parser);
+  subsumption_pruning::add_options_to_parser(parser);
   Options opts = parser.parse();
 
   shared_ptr<regression_lazy_search::RegressionLazySearch> engine;
@@ -9,6 +9,7 @@
 #include "../algorithms/ordered_set.h"
 #include "../front_to_front/front_to_front_open_list_factory.h"
 #include "../task_utils/task_properties.h"
+#include "fact_mutex_table.h"
 #include "regression_successor_generator.h"
 
 #include "../utils/logging.h"
@@ -28,19 +29,29 @@ RegressionEagerSearch::RegressionEagerSearch(const Options &opts)
       prune_goal(opts.get<bool>("prune_goal")),
       is_initial(true),
       bdd(opts.get<bool>("bdd")),
+      subsumption(opts.get<bool>("subsumption")),
       open_list(opts.get<shared_ptr<FrontToFrontOpenListFactory>>("open")
                     ->create_state_open_list()),
       f_evaluator(opts.get<shared_ptr<Evaluator>>("f_eval", nullptr)),
       preferred_operator_evaluators(
           opts.get_list<shared_ptr<FrontToFrontHeuristic>>("preferred")),
-      partial_state_task(tasks::PartialStateTask::get_partial_state_task()),
+      partial_state_task(tasks::PartialStateTask::get_partial_state_task(
+          opts.get<double>("h2_mutex_time_limit"))),
       partial_state_task_proxy(*partial_state_task),
-      regression_state_registry(partial_state_task_proxy),
+      regression_state_registry(
+          partial_state_task_proxy,
+          fact_mutex_table::FactMutexTable::get_root_mutex_table(
+              opts.get<double>("h2_mutex_time_limit"))),
       partial_state_search_space(regression_state_registry),
-      regression_task(tasks::RegressionTask::get_regression_task()),
+      regression_task(tasks::RegressionTask::get_regression_task(
+          opts.get<double>("h2_mutex_time_limit"))),
       regression_task_proxy(*regression_task),
-      regression_successor_generator(regression_task),
-      symbolic_closed_list(regression_task_proxy) {}
+      regression_successor_generator(
+          regression_task, opts.get<bool>("flat_successor_generator"),
+          opts.get<bool>("achiever_index")),
+      symbolic_closed_list(regression_task_proxy, opts),
+      subsumption_pruning(partial_state_task_proxy, regression_state_registry) {
+}
 
 void RegressionEagerSearch::initialize() {
   cout << "Conducting best first search"
@@ -105,6 +116,11 @@ void RegressionEagerSearch::initialize() {
 void RegressionEagerSearch::print_statistics() const {
   statistics.print_detailed_statistics();
   partial_state_search_space.print_statistics();
+  regression_state_registry.print_statistics();
+
+  if (bdd) symbolic_closed_list.PrintStatistics("Regression");
+  if (subsumption) subsumption_pruning.print_statistics("Regression");
+  open_list->print_statistics();
 }
 
 SearchStatus RegressionEagerSearch::step() {
@@ -133,6 +149,7 @@ SearchStatus RegressionEagerSearch::step() {
     EvaluationContext eval_context(s, node->get_g(), false, &statistics);
 
     node->close();
+    if (subsumption) subsumption_pruning.close(s, node->get_g());
 
     assert(!node->is_dead_end());
     update_f_value_statistics(eval_context);
@@ -144,18 +161,8 @@ SearchStatus RegressionEagerSearch::step() {
 
   const GlobalState &initial_state =
       regression_state_registry.get_initial_state();
-  VariablesProxy variables = partial_state_task_proxy.get_variables();
-  bool path_found = true;
-
-  for (auto var : variables) {
-    if (s[var.get_id()] != var.get_domain_size() - 1 &&
-        s[var.get_id()] != initial_state[var.get_id()]) {
-      path_found = false;
-      break;
-    }
-  }
 
-  if (path_found) {
+  if (regression_state_registry.subsumes(s, initial_state)) {
     Plan plan;
     partial_state_search_space.trace_path(s, plan);
     reverse(plan.begin(), plan.end());
@@ -164,7 +171,7 @@ SearchStatus RegressionEagerSearch::step() {
   }
 
   vector<OperatorID> applicable_ops;
-  regression_successor_generator.generate_applicable_ops(s, applicable_ops);
+  regression_successor_generator.generate_relevant_ops(s, applicable_ops);
 
   open_list->set_goal(s);
   EvaluationContext eval_context(initial_state, node->get_g(), false,
@@ -185,33 +192,9 @@ SearchStatus RegressionEagerSearch::step() {
   if (is_initial) is_initial = false;
 
   for (OperatorID op_id : applicable_ops) {
-    if (do_predecessor_pruning) {
-      OperatorProxy fop = task_proxy.get_operators()[op_id];
-      bool add_goal = false;
-
-      for (EffectProxy effect : fop.get_effects()) {
-        FactPair effect_pair = effect.get_fact().get_pair();
-        if (goal_state_values[effect_pair.var] == effect_pair.value) {
-          add_goal = true;
-          break;
-        }
-      }
-
-      if (!add_goal) continue;
-    }
-
-    OperatorProxy forward_op = task_proxy.get_operators()[op_id];
-    bool any = false;
-
-    for (EffectProxy effect : forward_op.get_effects()) {
-      FactPair effect_pair = effect.get_fact().get_pair();
-      if (s[effect_pair.var] == effect_pair.value) {
-        any = true;
-        break;
-      }
-    }
-
-    if (!any) continue;
+    if (do_predecessor_pruning &&
+        !regression_successor_generator.achieves_any(op_id, goal_state_values))
+      continue;
 
     OperatorProxy op = regression_task_proxy.get_operators()[op_id];
     if ((node->get_real_g() + op.get_cost()) >= bound) continue;
@@ -242,6 +225,13 @@ SearchStatus RegressionEagerSearch::step() {
       continue;
     }
 
+    if (subsumption && pre_node.is_new() &&
+        subsumption_pruning.prune(pre_state,
+                                  node->get_g() + get_adjusted_cost(op))) {
+      pre_node.close();
+      continue;
+    }
+
     // Previously encountered dead end. Don't re-evaluate.
     if (pre_node.is_dead_end()) continue;
 
@@ -352,5 +342,8 @@ void RegressionEagerSearch::update_f_value_statistics(
 void add_options_to_parser(OptionParser &parser) {
   SearchEngine::add_pruning_option(parser);
   SearchEngine::add_options_to_parser(parser);
+  regression_successor_generator::add_options_to_parser(parser);
+  fact_mutex_table::add_options_to_parser(parser);
+  subsumption_pruning::add_options_to_parser(parser);
 }
 }  // namespace regression_eager_search
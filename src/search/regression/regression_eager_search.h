@@ -12,6 +12,7 @@
 #include "regression_state_registry.h"
 #include "regression_successor_generator.h"
 #include "regression_task.h"
+#include "subsumption_pruning.h"
 #include "symbolic_closed.h"
 
 #include <memory>
@@ -31,6 +32,7 @@ class RegressionEagerSearch : public SearchEngine {
   bool prune_goal;
   bool is_initial;
   bool bdd;
+  bool subsumption;
 
   std::shared_ptr<FrontToFrontStateOpenList> open_list;
   std::shared_ptr<Evaluator> f_evaluator;
@@ -55,6 +57,7 @@ class RegressionEagerSearch : public SearchEngine {
   regression_successor_generator::RegressionSuccessorGenerator
       regression_successor_generator;
   symbolic_closed::SymbolicClosedList symbolic_closed_list;
+  subsumption_pruning::SubsumptionPruning subsumption_pruning;
 
   virtual void initialize() override;
   virtual SearchStatus step() override;
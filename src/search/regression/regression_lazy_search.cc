@@ -8,6 +8,8 @@
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
+#include "fact_mutex_table.h"
+
 #include <algorithm>
 #include <limits>
 #include <vector>
@@ -19,17 +21,26 @@ RegressionLazySearch::RegressionLazySearch(const Options &opts)
     : SearchEngine(opts),
       open_list(opts.get<shared_ptr<FrontToFrontOpenListFactory>>("open")
                     ->create_edge_open_list()),
-      partial_state_task(tasks::PartialStateTask::get_partial_state_task()),
+      partial_state_task(tasks::PartialStateTask::get_partial_state_task(
+          opts.get<double>("h2_mutex_time_limit"))),
       partial_state_task_proxy(*partial_state_task),
-      regression_state_registry(partial_state_task_proxy),
+      regression_state_registry(
+          partial_state_task_proxy,
+          fact_mutex_table::FactMutexTable::get_root_mutex_table(
+              opts.get<double>("h2_mutex_time_limit"))),
       partial_state_search_space(regression_state_registry),
-      regression_task(tasks::RegressionTask::get_regression_task()),
+      regression_task(tasks::RegressionTask::get_regression_task(
+          opts.get<double>("h2_mutex_time_limit"))),
       regression_task_proxy(*regression_task),
-      regression_successor_generator(regression_task),
-      symbolic_closed_list(regression_task_proxy),
+      regression_successor_generator(
+          regression_task, opts.get<bool>("flat_successor_generator"),
+          opts.get<bool>("achiever_index")),
+      symbolic_closed_list(regression_task_proxy, opts),
+      subsumption_pruning(partial_state_task_proxy, regression_state_registry),
       reopen_closed_nodes(opts.get<bool>("reopen_closed")),
       prune_goal(opts.get<bool>("prune_goal")),
       bdd(opts.get<bool>("bdd")),
+      subsumption(opts.get<bool>("subsumption")),
       randomize_successors(opts.get<bool>("randomize_successors")),
       preferred_successors_first(opts.get<bool>("preferred_successors_first")),
       rng(utils::parse_rng_from_options(opts)),
@@ -77,8 +88,8 @@ void RegressionLazySearch::initialize() {
 vector<OperatorID> RegressionLazySearch::get_successor_operators(
     const ordered_set::OrderedSet<OperatorID> &preferred_operators) const {
   vector<OperatorID> applicable_operators;
-  regression_successor_generator.generate_applicable_ops(current_state,
-                                                         applicable_operators);
+  regression_successor_generator.generate_relevant_ops(current_state,
+                                                       applicable_operators);
 
   if (randomize_successors) {
     rng->shuffle(applicable_operators);
@@ -150,19 +161,6 @@ SearchStatus RegressionLazySearch::fetch_next_state() {
     OperatorProxy current_operator =
         regression_task_proxy.get_operators()[current_operator_id];
 
-    OperatorProxy forward_op = task_proxy.get_operators()[current_operator_id];
-    bool any = false;
-
-    for (EffectProxy effect : forward_op.get_effects()) {
-      FactPair effect_pair = effect.get_fact().get_pair();
-      if (current_predecessor[effect_pair.var] == effect_pair.value) {
-        any = true;
-        break;
-      }
-    }
-
-    if (!any) continue;
-
     current_state_id = regression_state_registry.get_predecessor_state(
         current_predecessor, current_operator);
 
@@ -193,7 +191,8 @@ SearchStatus RegressionLazySearch::fetch_next_state() {
   open_list->set_goal(current_state);
   current_eval_context =
       EvaluationContext(regression_state_registry.get_initial_state(),
-                        current_g, true, &statistics);
+                        current_g, true, &statistics,
+                        !preferred_operator_evaluators.empty());
 
   return IN_PROGRESS;
 }
@@ -214,6 +213,10 @@ SearchStatus RegressionLazySearch::step() {
   if (node.is_new() && bdd && !symbolic_closed_list.CloseIfNot(current_state))
     node.close();
 
+  if (node.is_new() && subsumption &&
+      subsumption_pruning.prune(current_state, current_g))
+    node.close();
+
   bool reopen = reopen_closed_nodes && !node.is_new() && !node.is_dead_end() &&
                 (current_g < node.get_g());
 
@@ -250,6 +253,7 @@ SearchStatus RegressionLazySearch::step() {
         }
       }
       node.close();
+      if (subsumption) subsumption_pruning.close(current_state, current_g);
       if (check_initial_and_set_plan(current_state)) return SOLVED;
       if (search_progress.check_progress(current_eval_context)) {
         statistics.print_checkpoint_line(current_g);
@@ -273,20 +277,19 @@ void RegressionLazySearch::reward_progress() { open_list->boost_preferred(); }
 void RegressionLazySearch::print_statistics() const {
   statistics.print_detailed_statistics();
   partial_state_search_space.print_statistics();
+  regression_state_registry.print_statistics();
+
+  if (bdd) symbolic_closed_list.PrintStatistics("Regression");
+  if (subsumption) subsumption_pruning.print_statistics("Regression");
+  open_list->print_statistics();
 }
 
 bool RegressionLazySearch::check_initial_and_set_plan(
     const GlobalState &state) {
   const GlobalState &initial_state =
       regression_state_registry.get_initial_state();
-  VariablesProxy variables = regression_task_proxy.get_variables();
 
-  for (auto var : variables) {
-    if (state[var.get_id()] != var.get_domain_size() - 1 &&
-        state[var.get_id()] != initial_state[var.get_id()]) {
-      return false;
-    }
-  }
+  if (!regression_state_registry.subsumes(state, initial_state)) return false;
 
   Plan plan;
   partial_state_search_space.trace_path(state, plan);
@@ -1,40 +1,92 @@
 #include "regression_state_registry.h"
 
+#include "fact_mutex_table.h"
+
+#include <iostream>
+
 using namespace std;
 
-void RegressionStateRegistry::init_mutex() {
+static const int BITS_PER_WORD = 64;
+
+void RegressionStateRegistry::init_mutex_masks(
+    const fact_mutex_table::FactMutexTable &mutex_table) {
   TaskProxy task_proxy = get_task_proxy();
   VariablesProxy variables = task_proxy.get_variables();
 
-  fact_to_mutexes.resize(variables.size(), vector<vector<pair<int, int>>>());
+  unknown_values.reserve(variables.size());
+  domain_offsets.reserve(variables.size() + 1);
+  domain_offsets.push_back(0);
+
+  for (auto var : variables) {
+    // The last value is the unknown value, which is never in a domain.
+    int num_values = var.get_domain_size() - 1;
+    unknown_values.push_back(num_values);
+    int num_words = (num_values + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    int offset = domain_offsets.back();
+    domain_offsets.push_back(offset + num_words);
+    full_domains.resize(offset + num_words, 0);
+
+    for (int value = 0; value < num_values; ++value)
+      full_domains[offset + value / BITS_PER_WORD] |=
+          uint64_t(1) << (value % BITS_PER_WORD);
+  }
 
-  for (int var1 = 0, n = variables.size(); var1 < n; ++var1)
-    fact_to_mutexes[var1].resize(variables[var1].get_domain_size(),
-                                 vector<pair<int, int>>());
+  domains = full_domains;
+  fact_to_mutex_masks.resize(variables.size());
+
+  for (auto var : variables) {
+    int var_id = var.get_id();
+    fact_to_mutex_masks[var_id].resize(var.get_domain_size());
 
-  for (int var1 = 0, n = variables.size(); var1 < n; ++var1) {
-    for (int value1 = 0, m = variables[var1].get_domain_size() - 1; value1 < m;
-         ++value1) {
-      FactProxy fact1 = variables[var1].get_fact(value1);
+    for (int value = 0; value < unknown_values[var_id]; ++value) {
+      vector<MutexMask> &masks = fact_to_mutex_masks[var_id][value];
 
-      for (int var2 = var1 + 1, l = variables.size(); var2 < l; ++var2) {
-        for (int value2 = 0, o = variables[var2].get_domain_size() - 1;
-             value2 < o; ++value2) {
-          FactProxy fact2 = variables[var2].get_fact(value2);
+      // Mutexes are sorted by variable, so facts sharing a word are adjacent.
+      for (const FactPair &fact : mutex_table.get_mutexes(var_id, value)) {
+        int word = domain_offsets[fact.var] + fact.value / BITS_PER_WORD;
+        uint64_t bit = uint64_t(1) << (fact.value % BITS_PER_WORD);
 
-          if (fact1.is_mutex(fact2)) {
-            fact_to_mutexes[var1][value1].push_back(make_pair(var2, value2));
-            fact_to_mutexes[var2][value2].push_back(make_pair(var1, value1));
-          }
-        }
+        if (!masks.empty() && masks.back().word == word)
+          masks.back().mask |= bit;
+        else
+          masks.push_back({fact.var, word, bit});
       }
     }
   }
 }
 
-RegressionStateRegistry::RegressionStateRegistry(const TaskProxy &task_proxy)
-    : StateRegistry(task_proxy) {
-  init_mutex();
+void RegressionStateRegistry::init_bin_masks() {
+  int num_bins = get_bins_per_state();
+  unknown_bins.assign(num_bins, 0);
+  high_bits.assign(num_bins, 0);
+  low_bits.assign(num_bins, 0);
+
+  for (int var = 0; var < num_variables; ++var) {
+    int bin = state_packer.get_bin_index(var);
+    PackedStateBin read_mask = state_packer.get_read_mask(var);
+    if (read_mask == 0) continue;
+
+    // The highest set bit of read_mask.
+    PackedStateBin high_bit = read_mask & ~(read_mask >> 1);
+    high_bits[bin] |= high_bit;
+    low_bits[bin] |= read_mask & ~high_bit;
+    state_packer.set(unknown_bins.data(), var, unknown_values[var]);
+  }
+}
+
+bool RegressionStateRegistry::is_domain_empty(int var) const {
+  for (int word = domain_offsets[var]; word < domain_offsets[var + 1]; ++word)
+    if (domains[word] != 0) return false;
+
+  return true;
+}
+
+RegressionStateRegistry::RegressionStateRegistry(
+    const TaskProxy &task_proxy,
+    const fact_mutex_table::FactMutexTable &mutex_table)
+    : StateRegistry(task_proxy), num_mutex_rejections(0) {
+  init_mutex_masks(mutex_table);
+  init_bin_masks();
 }
 
 RegressionStateRegistry::~RegressionStateRegistry() {}
@@ -61,7 +113,7 @@ StateID RegressionStateRegistry::get_predecessor_state(
 
     if (value == var.get_domain_size() - 1)
       has_mutex = true;
-    else if (!fact_to_mutexes[var.get_id()][value].empty())
+    else if (!fact_to_mutex_masks[var.get_id()][value].empty())
       has_undefined = true;
 
     if (has_mutex && has_undefined) break;
@@ -69,12 +121,7 @@ StateID RegressionStateRegistry::get_predecessor_state(
 
   if (!has_mutex && !has_undefined) return insert_id_or_pop_state();
 
-  vector<unordered_set<int>> ranges(variables.size(), unordered_set<int>());
-
-  for (auto var : variables)
-    for (int value = 0; value < var.get_domain_size() - 1; ++value)
-      ranges[var.get_id()].insert(value);
-
+  domains.assign(full_domains.begin(), full_domains.end());
   bool invalid = false;
 
   for (auto var : variables) {
@@ -84,16 +131,22 @@ StateID RegressionStateRegistry::get_predecessor_state(
 
     if (value == var.get_domain_size() - 1) continue;
 
-    for (auto fact : fact_to_mutexes[var.get_id()][value]) {
-      if (state_packer.get(buffer, fact.first) == fact.second) {
+    for (const MutexMask &mutex_mask :
+         fact_to_mutex_masks[var.get_id()][value]) {
+      int mutex_var = mutex_mask.var;
+      int mutex_value = state_packer.get(buffer, mutex_var);
+
+      if (mutex_value != unknown_values[mutex_var] &&
+          domain_offsets[mutex_var] + mutex_value / BITS_PER_WORD ==
+              mutex_mask.word &&
+          ((mutex_mask.mask >> (mutex_value % BITS_PER_WORD)) & 1)) {
         invalid = true;
         break;
       }
 
-      auto result = ranges[fact.first].find(fact.second);
-      if (result != ranges[fact.first].end()) ranges[fact.first].erase(result);
+      domains[mutex_mask.word] &= ~mutex_mask.mask;
 
-      if (ranges[fact.first].empty()) {
+      if (domains[mutex_mask.word] == 0 && is_domain_empty(mutex_var)) {
         invalid = true;
         break;
       }
@@ -102,6 +155,7 @@ StateID RegressionStateRegistry::get_predecessor_state(
 
   if (invalid) {
     state_data_pool.pop_back();
+    ++num_mutex_rejections;
     return StateID::no_state;
   }
 
@@ -110,9 +164,47 @@ StateID RegressionStateRegistry::get_predecessor_state(
 
     if (value != var.get_domain_size() - 1) continue;
 
-    if (ranges[var.get_id()].size() == 1)
-      state_packer.set(buffer, var.get_id(), *ranges[var.get_id()].begin());
+    // Set the variable if exactly one value is not mutex with the others.
+    int remaining_value = -1;
+
+    for (int word = domain_offsets[var.get_id()];
+         word < domain_offsets[var.get_id() + 1]; ++word) {
+      uint64_t bits = domains[word];
+      if (bits == 0) continue;
+
+      if (remaining_value != -1 || (bits & (bits - 1)) != 0) {
+        remaining_value = -1;
+        break;
+      }
+
+      remaining_value = (word - domain_offsets[var.get_id()]) * BITS_PER_WORD;
+      while (((bits >> (remaining_value % BITS_PER_WORD)) & 1) == 0)
+        ++remaining_value;
+    }
+
+    if (remaining_value != -1)
+      state_packer.set(buffer, var.get_id(), remaining_value);
   }
 
   return insert_id_or_pop_state();
-}
\ No newline at end of file
+}
+
+bool RegressionStateRegistry::subsumes(const GlobalState &partial_state,
+                                       const GlobalState &state) const {
+  const PackedStateBin *partial_buffer = get_packed_buffer(partial_state);
+  const PackedStateBin *buffer = get_packed_buffer(state);
+
+  for (int bin = 0, n = unknown_bins.size(); bin < n; ++bin) {
+    PackedStateBin defined =
+        get_nonzero_variables(bin, partial_buffer[bin] ^ unknown_bins[bin]);
+    PackedStateBin different =
+        get_nonzero_variables(bin, partial_buffer[bin] ^ buffer[bin]);
+    if ((defined & different) != 0) return false;
+  }
+
+  return true;
+}
+
+void RegressionStateRegistry::print_statistics() const {
+  cout << "Predecessors rejected by mutexes: " << num_mutex_rejections << endl;
+}
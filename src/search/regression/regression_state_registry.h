@@ -14,21 +14,71 @@
 #include "../algorithms/subscriber.h"
 #include "../utils/hash.h"
 
+#include <cstdint>
 #include <set>
 #include <utility>
 #include <vector>
 
+namespace fact_mutex_table {
+class FactMutexTable;
+}
+
 class RegressionStateRegistry : public StateRegistry {
-  std::vector<std::vector<std::vector<std::pair<int, int>>>> fact_to_mutexes;
+  /*
+    The values of a variable that are not mutex with the defined facts of
+    a predecessor are kept as a bitset of the words
+    [domain_offsets[var], domain_offsets[var + 1]) in domains. A mutex
+    mask removes the values of var in one word that are mutex with a
+    fact.
+  */
+  struct MutexMask {
+    int var;
+    int word;
+    uint64_t mask;
+  };
+
+  std::vector<std::vector<std::vector<MutexMask>>> fact_to_mutex_masks;
+  std::vector<int> unknown_values;
+  std::vector<int> domain_offsets;
+  std::vector<uint64_t> full_domains;
+  std::vector<uint64_t> domains;
+
+  /*
+    Per bin of a packed state: the unknown values of all variables, the
+    highest bit of each variable and the other bits of each variable.
+  */
+  std::vector<PackedStateBin> unknown_bins;
+  std::vector<PackedStateBin> high_bits;
+  std::vector<PackedStateBin> low_bits;
+
+  long long num_mutex_rejections;
 
-  void init_mutex();
+  void init_mutex_masks(const fact_mutex_table::FactMutexTable &mutex_table);
+  void init_bin_masks();
+  bool is_domain_empty(int var) const;
+
+  // Set the highest bit of each variable whose bits in bin are not all 0.
+  PackedStateBin get_nonzero_variables(int bin, PackedStateBin bits) const {
+    return (((bits & low_bits[bin]) + low_bits[bin]) | bits) & high_bits[bin];
+  }
 
  public:
-  explicit RegressionStateRegistry(const TaskProxy &task_proxy);
+  RegressionStateRegistry(const TaskProxy &task_proxy,
+                          const fact_mutex_table::FactMutexTable &mutex_table);
   ~RegressionStateRegistry();
 
   StateID get_predecessor_state(const GlobalState &predecessor,
                                 const OperatorProxy &op);
+
+  /*
+    Return true if state has the value of each variable that is defined
+    in partial_state. Both states must be registered in this registry.
+    Whole bins of packed values are compared at once.
+  */
+  bool subsumes(const GlobalState &partial_state,
+                const GlobalState &state) const;
+
+  void print_statistics() const;
 };
 
 #endif
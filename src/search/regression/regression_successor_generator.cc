@@ -1,25 +1,77 @@
 #include "regression_successor_generator.h"
 
 #include "../global_state.h"
+#include "../option_parser.h"
 #include "regression_successor_generator_factory.h"
+#include "regression_successor_generator_internals.h"
+
+#include "../utils/memory.h"
+
+#include <algorithm>
 
 using namespace std;
 
 namespace regression_successor_generator {
 RegressionSuccessorGenerator::RegressionSuccessorGenerator(
-    shared_ptr<const tasks::RegressionTask> task)
-    : root(RegressionSuccessorGeneratorFactory(task).create()) {}
+    shared_ptr<const tasks::RegressionTask> task, bool flat,
+    bool use_achiever_index)
+    : use_achiever_index(use_achiever_index) {
+  RegressionSuccessorGeneratorFactory factory(task);
+
+  if (flat)
+    flat_root = factory.create_flat();
+  else
+    root = factory.create();
+
+  achievers = utils::make_unique_ptr<achiever_index::AchieverIndex>(
+      task, factory.get_operator_order());
+}
 
 RegressionSuccessorGenerator::~RegressionSuccessorGenerator() = default;
 
 void RegressionSuccessorGenerator::generate_applicable_ops(
     const State &state, vector<OperatorID> &applicable_ops) const {
-  root->generate_applicable_ops(state, applicable_ops);
+  if (flat_root)
+    flat_root->generate_applicable_ops(state, applicable_ops);
+  else
+    root->generate_applicable_ops(state, applicable_ops);
 }
 
 void RegressionSuccessorGenerator::generate_applicable_ops(
     const GlobalState &state, vector<OperatorID> &applicable_ops) const {
-  root->generate_applicable_ops(state, applicable_ops);
+  if (flat_root)
+    flat_root->generate_applicable_ops(state, applicable_ops);
+  else
+    root->generate_applicable_ops(state, applicable_ops);
+}
+
+void RegressionSuccessorGenerator::generate_relevant_ops(
+    const GlobalState &state, vector<OperatorID> &relevant_ops) const {
+  if (use_achiever_index) {
+    achievers->generate_relevant_ops(state, relevant_ops);
+    return;
+  }
+
+  size_t begin = relevant_ops.size();
+  generate_applicable_ops(state, relevant_ops);
+  auto last = remove_if(
+      relevant_ops.begin() + begin, relevant_ops.end(),
+      [this, &state](OperatorID op) { return !is_relevant(op, state); });
+  relevant_ops.erase(last, relevant_ops.end());
+}
+
+void add_options_to_parser(options::OptionParser &parser) {
+  parser.add_option<bool>(
+      "flat_successor_generator",
+      "store the regression successor generator in one array and read "
+      "values directly from packed states",
+      "false");
+  parser.add_option<bool>(
+      "achiever_index",
+      "enumerate the operators of backward expansions from the achievers "
+      "of the facts of the state instead of filtering all applicable "
+      "operators",
+      "true");
 }
 
 }  // namespace regression_successor_generator
@@ -2,6 +2,7 @@
 #define REGRESSION_SUCCESSOR_GENERATOR_H
 
 #include "../task_utils/successor_generator_internals.h"
+#include "achiever_index.h"
 #include "regression_task.h"
 
 #include <memory>
@@ -10,13 +11,34 @@ class GlobalState;
 class State;
 class OperatorID;
 
+namespace options {
+class OptionParser;
+}
+
 namespace regression_successor_generator {
+class FlatGenerator;
+
+/*
+  With flat = true, the decision tree is stored in one array and
+  traversed without virtual calls, reading the values of registered
+  states directly from their packed buffers. Both generators return
+  the same operators in the same order.
+
+  Backward expansions only need the applicable operators that achieve
+  a fact of the partial state. With achiever_index = true, they are
+  enumerated from the achievers of the defined facts instead of being
+  filtered from all applicable operators.
+*/
 class RegressionSuccessorGenerator {
   std::unique_ptr<successor_generator::GeneratorBase> root;
+  std::unique_ptr<FlatGenerator> flat_root;
+  std::unique_ptr<achiever_index::AchieverIndex> achievers;
+  bool use_achiever_index;
 
  public:
   explicit RegressionSuccessorGenerator(
-      std::shared_ptr<const tasks::RegressionTask> task);
+      std::shared_ptr<const tasks::RegressionTask> task, bool flat = false,
+      bool use_achiever_index = false);
 
   ~RegressionSuccessorGenerator();
 
@@ -24,8 +46,21 @@ class RegressionSuccessorGenerator {
                                std::vector<OperatorID> &applicable_ops) const;
   void generate_applicable_ops(const GlobalState &state,
                                std::vector<OperatorID> &applicable_ops) const;
+
+  // Applicable operators that achieve a fact defined in the state.
+  void generate_relevant_ops(const GlobalState &state,
+                             std::vector<OperatorID> &relevant_ops) const;
+
+  bool is_relevant(OperatorID op, const GlobalState &state) const {
+    return achievers->is_relevant(op, state);
+  }
+
+  bool achieves_any(OperatorID op, const std::vector<int> &values) const {
+    return achievers->achieves_any(op, values);
+  }
 };
 
+void add_options_to_parser(options::OptionParser &parser);
 }  // namespace regression_successor_generator
 
 #endif
\ No newline at end of file
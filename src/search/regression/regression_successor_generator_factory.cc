@@ -209,6 +209,73 @@ GeneratorPtr RegressionSuccessorGeneratorFactory::construct_recursive(
   return construct_fork(move(nodes));
 }
 
+int RegressionSuccessorGeneratorFactory::construct_flat_leaf(
+    RegressionOperatorRange range, vector<FlatGeneratorNode> &nodes,
+    vector<OperatorID> &operators) const {
+  assert(!range.empty());
+  int first = operators.size();
+  while (range.begin != range.end) {
+    operators.emplace_back(operator_infos[range.begin].get_op());
+    ++range.begin;
+  }
+
+  nodes.push_back({FlatGeneratorNode::LEAF, first,
+                   static_cast<int>(operators.size()), -1, -1, -1});
+  return nodes.size() - 1;
+}
+
+/*
+  Mirrors construct_recursive, so the flat generator visits the
+  operators in the same order. Returns the index of the first of the
+  sibling nodes, which replace the fork, or -1 if the range is empty.
+*/
+int RegressionSuccessorGeneratorFactory::construct_flat_recursive(
+    int depth, RegressionOperatorRange range, vector<FlatGeneratorNode> &nodes,
+    vector<OperatorID> &operators) const {
+  int first = -1;
+  int last = -1;
+  RegressionOperatorGrouper grouper_by_fact(operator_infos, depth, range);
+  while (!grouper_by_fact.done()) {
+    auto fact_group = grouper_by_fact.next_by_fact();
+    FactPair fact = fact_group.first;
+    RegressionOperatorRange fact_range = fact_group.second;
+    int index = -1;
+
+    if (fact.var == -1) {
+      index = construct_flat_leaf(fact_range, nodes, operators);
+    } else {
+      index = nodes.size();
+      nodes.push_back({fact.var, fact.value,
+                       task->get_variable_domain_size(fact.var) - 1, -1, -1,
+                       -1});
+      RegressionOperatorGrouper grouper_by_is_negative(operator_infos, depth,
+                                                       fact_range);
+
+      while (!grouper_by_is_negative.done()) {
+        auto is_negative_group = grouper_by_is_negative.next_by_is_negative();
+        bool is_negative = is_negative_group.first;
+        RegressionOperatorRange is_negative_range = is_negative_group.second;
+        int child = construct_flat_recursive(depth + 1, is_negative_range,
+                                             nodes, operators);
+
+        // The vector may have grown, so we cannot keep a reference.
+        if (is_negative)
+          nodes[index].false_child = child;
+        else
+          nodes[index].true_child = child;
+      }
+    }
+
+    if (last == -1)
+      first = index;
+    else
+      nodes[last].next = index;
+    last = index;
+  }
+
+  return first;
+}
+
 vector<RegressionPrecondition>
 RegressionSuccessorGeneratorFactory::build_sorted_precondition(int op_index) {
   vector<RegressionPrecondition> precond;
@@ -227,8 +294,7 @@ RegressionSuccessorGeneratorFactory::build_sorted_precondition(int op_index) {
   return precond;
 }
 
-GeneratorPtr RegressionSuccessorGeneratorFactory::create() {
-  cout << "creating regression successor generator" << endl;
+void RegressionSuccessorGeneratorFactory::init_operator_infos() {
   operator_infos.reserve(task->get_num_operators());
 
   for (int i = 0; i < task->get_num_operators(); ++i) {
@@ -237,10 +303,47 @@ GeneratorPtr RegressionSuccessorGeneratorFactory::create() {
   }
 
   stable_sort(operator_infos.begin(), operator_infos.end());
+}
+
+GeneratorPtr RegressionSuccessorGeneratorFactory::create() {
+  cout << "creating regression successor generator" << endl;
+  init_operator_infos();
 
   RegressionOperatorRange full_range(0, operator_infos.size());
   GeneratorPtr root = construct_recursive(0, full_range);
   operator_infos.clear();
   return root;
 }
+
+/*
+  Operators with equal preconditions stay in the same leaf, and all
+  leaves are visited in preorder, so this is the order of operator_infos.
+*/
+vector<OperatorID> RegressionSuccessorGeneratorFactory::get_operator_order() {
+  init_operator_infos();
+  vector<OperatorID> order;
+  order.reserve(operator_infos.size());
+
+  for (const RegressionOperatorInfo &info : operator_infos)
+    order.push_back(info.get_op());
+
+  operator_infos.clear();
+  return order;
+}
+
+unique_ptr<FlatGenerator> RegressionSuccessorGeneratorFactory::create_flat() {
+  cout << "creating flat regression successor generator" << endl;
+  init_operator_infos();
+
+  vector<FlatGeneratorNode> nodes;
+  vector<OperatorID> operators;
+  operators.reserve(operator_infos.size());
+  RegressionOperatorRange full_range(0, operator_infos.size());
+  int root = construct_flat_recursive(0, full_range, nodes, operators);
+  operator_infos.clear();
+
+  nodes.shrink_to_fit();
+  return utils::make_unique_ptr<FlatGenerator>(
+      move(nodes), move(operators), root, task->get_num_variables());
+}
 }  // namespace regression_successor_generator
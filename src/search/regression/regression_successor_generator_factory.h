@@ -16,6 +16,8 @@ using GeneratorPtr = std::unique_ptr<successor_generator::GeneratorBase>;
 struct RegressionPrecondition;
 struct RegressionOperatorRange;
 class RegressionOperatorInfo;
+class FlatGenerator;
+struct FlatGeneratorNode;
 
 class RegressionSuccessorGeneratorFactory {
   using ValuesAndGenerators = std::vector<std::pair<int, GeneratorPtr>>;
@@ -30,11 +32,23 @@ class RegressionSuccessorGeneratorFactory {
   GeneratorPtr construct_recursive(int depth,
                                    RegressionOperatorRange range) const;
 
+  int construct_flat_leaf(RegressionOperatorRange range,
+                          std::vector<FlatGeneratorNode> &nodes,
+                          std::vector<OperatorID> &operators) const;
+  int construct_flat_recursive(int depth, RegressionOperatorRange range,
+                               std::vector<FlatGeneratorNode> &nodes,
+                               std::vector<OperatorID> &operators) const;
+
+  void init_operator_infos();
+
  public:
   explicit RegressionSuccessorGeneratorFactory(
       std::shared_ptr<const tasks::RegressionTask> task);
   ~RegressionSuccessorGeneratorFactory();
   GeneratorPtr create();
+  std::unique_ptr<FlatGenerator> create_flat();
+  // The order in which the generators visit the operators.
+  std::vector<OperatorID> get_operator_order();
 };
 
 }  // namespace regression_successor_generator
@@ -1,6 +1,7 @@
 #include "regression_successor_generator_internals.h"
 
 #include "../global_state.h"
+#include "../state_registry.h"
 #include "../task_proxy.h"
 
 #include <cassert>
@@ -56,4 +57,77 @@ void GeneratorSwitchFact::generate_applicable_ops(
   }
 }
 
+const int FlatGeneratorNode::LEAF;
+
+FlatGenerator::FlatGenerator(vector<FlatGeneratorNode> &&nodes,
+                             vector<OperatorID> &&operators, int root,
+                             int num_variables)
+    : nodes(move(nodes)),
+      operators(move(operators)),
+      root(root),
+      num_variables(num_variables),
+      packer(nullptr) {}
+
+void FlatGenerator::init_layouts(
+    const int_packer::IntPacker &state_packer) const {
+  packer = &state_packer;
+  layouts.reserve(num_variables);
+
+  for (int var = 0; var < num_variables; ++var) {
+    int_packer::IntPacker::Bin mask = state_packer.get_read_mask(var);
+    int shift = 0;
+    while (mask != 0 && ((mask >> shift) & 1) == 0) ++shift;
+    layouts.push_back({state_packer.get_bin_index(var), mask, shift});
+  }
+}
+
+template <typename ValueReader>
+void FlatGenerator::generate_applicable_ops(
+    const ValueReader &read_value, int node_index,
+    vector<OperatorID> &applicable_ops) const {
+  while (node_index != -1) {
+    const FlatGeneratorNode &node = nodes[node_index];
+
+    if (node.var == FlatGeneratorNode::LEAF) {
+      applicable_ops.insert(applicable_ops.end(),
+                            operators.begin() + node.value,
+                            operators.begin() + node.unknown_value);
+    } else {
+      int value = read_value(node.var);
+
+      if (value == node.unknown_value) {
+        generate_applicable_ops(read_value, node.true_child, applicable_ops);
+        generate_applicable_ops(read_value, node.false_child, applicable_ops);
+      } else if (value == node.value) {
+        generate_applicable_ops(read_value, node.true_child, applicable_ops);
+      } else {
+        generate_applicable_ops(read_value, node.false_child, applicable_ops);
+      }
+    }
+
+    node_index = node.next;
+  }
+}
+
+void FlatGenerator::generate_applicable_ops(
+    const State &state, vector<OperatorID> &applicable_ops) const {
+  auto read_value = [&state](int var) { return state[var].get_value(); };
+  generate_applicable_ops(read_value, root, applicable_ops);
+}
+
+void FlatGenerator::generate_applicable_ops(
+    const GlobalState &state, vector<OperatorID> &applicable_ops) const {
+  const int_packer::IntPacker &state_packer =
+      state.get_registry().get_state_packer();
+  if (!packer) init_layouts(state_packer);
+  assert(packer == &state_packer);
+
+  const int_packer::IntPacker::Bin *buffer = state.get_packed_buffer();
+  auto read_value = [this, buffer](int var) {
+    const VariableLayout &layout = layouts[var];
+    return static_cast<int>((buffer[layout.bin] & layout.mask) >> layout.shift);
+  };
+  generate_applicable_ops(read_value, root, applicable_ops);
+}
+
 }  // namespace regression_successor_generator
@@ -3,9 +3,11 @@
 
 #include "../abstract_task.h"
 #include "../operator_id.h"
+#include "../algorithms/int_packer.h"
 #include "../task_utils/successor_generator_internals.h"
 
 #include <memory>
+#include <vector>
 
 class GlobalState;
 class State;
@@ -31,6 +33,64 @@ class GeneratorSwitchFact : public successor_generator::GeneratorBase {
       std::vector<OperatorID> &applicable_ops) const override;
 };
 
+/*
+  The decision tree of GeneratorSwitchFact, fork and leaf nodes stored
+  in one array in preorder. Forks are replaced by links to the next
+  sibling, and leaves store a range of an array of operators. Values
+  are read directly from the packed state with the layout of the
+  state packer of its registry, which is taken from the first state
+  that the generator sees. All states must use the same packer.
+*/
+struct FlatGeneratorNode {
+  // The variable of a switch node, or LEAF.
+  int var;
+  // The value of a switch node, or the first operator of a leaf.
+  int value;
+  // The unknown value of var, or the end of the operators of a leaf.
+  int unknown_value;
+  // Index of the nodes for the value and other values, or -1.
+  int true_child;
+  int false_child;
+  // Index of the next sibling, or -1.
+  int next;
+
+  static const int LEAF = -1;
+};
+
+class FlatGenerator {
+  struct VariableLayout {
+    int bin;
+    int_packer::IntPacker::Bin mask;
+    int shift;
+  };
+
+  std::vector<FlatGeneratorNode> nodes;
+  std::vector<OperatorID> operators;
+  int root;
+  int num_variables;
+  // Filled on the first call with a GlobalState.
+  mutable const int_packer::IntPacker *packer;
+  mutable std::vector<VariableLayout> layouts;
+
+  void init_layouts(const int_packer::IntPacker &state_packer) const;
+
+  template <typename ValueReader>
+  void generate_applicable_ops(const ValueReader &read_value, int node_index,
+                               std::vector<OperatorID> &applicable_ops) const;
+
+ public:
+  FlatGenerator(std::vector<FlatGeneratorNode> &&nodes,
+                std::vector<OperatorID> &&operators, int root,
+                int num_variables);
+
+  void generate_applicable_ops(const State &state,
+                               std::vector<OperatorID> &applicable_ops) const;
+  void generate_applicable_ops(const GlobalState &state,
+                               std::vector<OperatorID> &applicable_ops) const;
+
+  int get_num_nodes() const { return nodes.size(); }
+};
+
 }  // namespace regression_successor_generator
 
 #endif
\ No newline at end of file
@@ -15,33 +15,6 @@ using namespace std;
 
 namespace tasks {
 
-void RegressionTask::init_mutex() {
-  fact_to_mutexes.resize(get_num_variables(), vector<vector<FactPair>>());
-
-  for (int var1 = 0; var1 < get_num_variables(); ++var1)
-    fact_to_mutexes[var1].resize(get_variable_domain_size(var1),
-                                 vector<FactPair>());
-
-  for (int var1 = 0; var1 < get_num_variables(); ++var1) {
-    for (int value1 = 0; value1 < get_variable_domain_size(var1) - 1;
-         ++value1) {
-      FactPair fact1(var1, value1);
-
-      for (int var2 = var1 + 1; var2 < get_num_variables(); ++var2) {
-        for (int value2 = 0; value2 < get_variable_domain_size(var2) - 1;
-             ++value2) {
-          FactPair fact2(var2, value2);
-
-          if (are_facts_mutex(fact1, fact2)) {
-            fact_to_mutexes[var1][value1].push_back(fact2);
-            fact_to_mutexes[var2][value2].push_back(fact1);
-          }
-        }
-      }
-    }
-  }
-}
-
 void RegressionTask::reverse_operators() {
   cout << "inversing operators" << endl;
 
@@ -67,7 +40,7 @@ void RegressionTask::reverse_operators() {
       effect_var_values[fact.var] = fact.value;
       new_preconditions.push_back(fact);
 
-      for (auto f : fact_to_mutexes[fact.var][fact.value])
+      for (auto f : mutex_table.get_mutexes(fact.var, fact.value))
         new_negative_preconditons.push_back(f);
     }
 
@@ -82,7 +55,7 @@ void RegressionTask::reverse_operators() {
       FactPair fact = parent->get_operator_precondition(i, j, false);
       precondition_var_values[fact.var] = fact.value;
 
-      for (auto f : fact_to_mutexes[fact.var][fact.value]) {
+      for (auto f : mutex_table.get_mutexes(fact.var, fact.value)) {
         auto result = ranges[f.var].find(f.value);
 
         if (result != ranges[f.var].end()) ranges[f.var].erase(result);
@@ -113,7 +86,7 @@ void RegressionTask::reverse_operators() {
       if (effect_var_values[var] == -1) {
         new_preconditions.push_back(FactPair(var, value));
 
-        for (auto f : fact_to_mutexes[var][value])
+        for (auto f : mutex_table.get_mutexes(var, value))
           new_negative_preconditons.push_back(f);
       }
 
@@ -143,9 +116,11 @@ void RegressionTask::reverse_operators() {
   }
 }
 
-RegressionTask::RegressionTask(const shared_ptr<AbstractTask> &parent)
-    : parent(parent) {
-  init_mutex();
+RegressionTask::RegressionTask(const shared_ptr<AbstractTask> &parent,
+                               double h2_time_limit)
+    : mutex_table(fact_mutex_table::FactMutexTable::get_root_mutex_table(
+          h2_time_limit)),
+      parent(parent) {
   reverse_operators();
 }
 
@@ -171,7 +146,7 @@ vector<int> RegressionTask::get_goal_state_values() const {
 
     if (value == get_variable_domain_size(var) - 1) continue;
 
-    for (auto fact : fact_to_mutexes[var][value]) {
+    for (auto fact : mutex_table.get_mutexes(var, value)) {
       auto result = ranges[fact.var].find(fact.value);
       if (result != ranges[fact.var].end()) ranges[fact.var].erase(result);
     }
@@ -219,7 +194,8 @@ string RegressionTask::get_fact_name(const FactPair &fact) const {
 
 bool RegressionTask::are_facts_mutex(const FactPair &fact1,
                                      const FactPair &fact2) const {
-  return parent->are_facts_mutex(fact1, fact2);
+  if (fact1.var == fact2.var) return parent->are_facts_mutex(fact1, fact2);
+  return mutex_table.are_mutex(fact1, fact2);
 }
 
 int RegressionTask::get_operator_cost(int index, bool is_axiom) const {
@@ -296,12 +272,14 @@ void RegressionTask::convert_state_values(
 }
 
 static shared_ptr<AbstractTask> _parse(OptionParser &parser) {
+  fact_mutex_table::add_options_to_parser(parser);
   Options opts = parser.parse();
 
   if (parser.dry_run())
     return nullptr;
   else
-    return RegressionTask::get_regression_task();
+    return RegressionTask::get_regression_task(
+        opts.get<double>("h2_mutex_time_limit"));
 }
 
 static Plugin<AbstractTask> _plugin("regression", _parse);
@@ -1,6 +1,7 @@
 #ifndef REGRESSION_TASK_H
 #define REGRESSION_TASK_H
 
+#include <map>
 #include <memory>
 #include <stack>
 #include <string>
@@ -9,6 +10,7 @@
 #include <vector>
 
 #include "../abstract_task.h"
+#include "fact_mutex_table.h"
 #include "partial_state_task.h"
 
 using namespace std;
@@ -22,16 +24,16 @@ namespace tasks {
 class RegressionTask : public AbstractTask {
   vector<ExplicitOperator> operators;
   vector<vector<bool>> is_negative_precondition_vector;
-  vector<vector<vector<FactPair>>> fact_to_mutexes;
+  const fact_mutex_table::FactMutexTable &mutex_table;
 
  protected:
   const std::shared_ptr<AbstractTask> parent;
 
-  void init_mutex();
   void reverse_operators();
 
  public:
-  RegressionTask(const std::shared_ptr<AbstractTask> &parent);
+  RegressionTask(const std::shared_ptr<AbstractTask> &parent,
+                 double h2_time_limit);
   virtual ~RegressionTask() override = default;
 
   bool is_negative_precondition(int op_index, int fact_index,
@@ -80,10 +82,15 @@ class RegressionTask : public AbstractTask {
       const AbstractTask *ancestor_task) const final override;
   virtual void convert_state_values_from_parent(std::vector<int> &) const {}
 
-  static std::shared_ptr<RegressionTask> get_regression_task() {
-    static std::shared_ptr<RegressionTask> task =
-        std::make_shared<RegressionTask>(
-            PartialStateTask::get_partial_state_task());
+  // There is one regression task per h^2 time limit of its mutexes.
+  static std::shared_ptr<RegressionTask> get_regression_task(
+      double h2_time_limit) {
+    static std::map<double, std::shared_ptr<RegressionTask>> tasks;
+    std::shared_ptr<RegressionTask> &task = tasks[h2_time_limit];
+    if (!task)
+      task = std::make_shared<RegressionTask>(
+          PartialStateTask::get_partial_state_task(h2_time_limit),
+          h2_time_limit);
 
     return task;
   }
@@ -0,0 +1,61 @@
+#include "subsumption_pruning.h"
+
+#include "../option_parser.h"
+#include "../state_registry.h"
+
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace subsumption_pruning {
+SubsumptionPruning::SubsumptionPruning(const TaskProxy &task_proxy,
+                                       const StateRegistry &registry)
+    : registry(registry),
+      closed_states(task_proxy),
+      closed_g(numeric_limits<int>::max()),
+      num_checks(0),
+      num_pruned(0) {
+  check_timer.stop();
+}
+
+void SubsumptionPruning::close(const GlobalState &state, int g) {
+  int &old_g = closed_g[state];
+
+  if (old_g == numeric_limits<int>::max()) closed_states.insert(state);
+
+  if (g < old_g) old_g = g;
+}
+
+bool SubsumptionPruning::prune(const GlobalState &state, int g) {
+  check_timer.resume();
+  ++num_checks;
+
+  StateID subsuming_id = closed_states.find_subsuming_state(
+      state, [this, g](StateID id) {
+        return closed_g[registry.lookup_state(id)] <= g;
+      });
+
+  bool pruned = subsuming_id != StateID::no_state;
+  if (pruned) ++num_pruned;
+
+  check_timer.stop();
+  return pruned;
+}
+
+void SubsumptionPruning::print_statistics(const string &name) const {
+  cout << name << " subsumption checks: " << num_checks << endl;
+  cout << name << " subsumption pruned: " << num_pruned << endl;
+  cout << name << " subsumption time: " << check_timer << endl;
+  cout << name << " subsumption closed states: " << closed_states.size()
+       << " (" << closed_states.get_num_nodes() << " nodes)" << endl;
+}
+
+void add_options_to_parser(options::OptionParser &parser) {
+  parser.add_option<bool>(
+      "subsumption",
+      "prune backward states that are subsumed by a closed backward state "
+      "with lower or equal g",
+      "false");
+}
+}  // namespace subsumption_pruning
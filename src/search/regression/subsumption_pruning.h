@@ -0,0 +1,53 @@
+#ifndef SUBSUMPTION_PRUNING_H_
+#define SUBSUMPTION_PRUNING_H_
+
+#include "../global_state.h"
+#include "../per_state_information.h"
+#include "../task_proxy.h"
+#include "../utils/timer.h"
+#include "partial_state_index.h"
+
+#include <string>
+
+class StateRegistry;
+
+namespace options {
+class OptionParser;
+}
+
+namespace subsumption_pruning {
+/*
+  Prunes backward states that are subsumed by a closed backward state,
+  i.e., a closed partial state whose defined facts are all defined in
+  the new state, with lower or equal g. Every plan from the initial
+  state to the new state also reaches the closed state, which was
+  reached at most as expensively, so the new state is never needed.
+
+  The closed states are stored in a PartialStateIndex, so a check
+  does not scan all closed states.
+*/
+class SubsumptionPruning {
+  const StateRegistry &registry;
+  partial_state_index::PartialStateIndex closed_states;
+  PerStateInformation<int> closed_g;
+
+  int num_checks;
+  int num_pruned;
+  utils::Timer check_timer;
+
+ public:
+  SubsumptionPruning(const TaskProxy &task_proxy,
+                     const StateRegistry &registry);
+
+  void close(const GlobalState &state, int g);
+
+  // Whether the state is subsumed by a closed state with lower or equal g.
+  bool prune(const GlobalState &state, int g);
+
+  void print_statistics(const std::string &name) const;
+};
+
+void add_options_to_parser(options::OptionParser &parser);
+}  // namespace subsumption_pruning
+
+#endif  // SUBSUMPTION_PRUNING_H_
@@ -2,19 +2,30 @@
 
 #include "../options/option_parser.h"
 #include "../options/options.h"
+#include "../tasks/root_task.h"
 
 #include <cmath>
 
 #include <iostream>
 #include <string>
+#include <utility>
 
 namespace symbolic_closed {
 
-SymbolicClosedList::SymbolicClosedList(const TaskProxy &task_proxy)
+SymbolicClosedList::SymbolicClosedList(const TaskProxy &task_proxy,
+                                       const options::Options &opts)
     : n_bdd_vars(0),
-      cudd_init_nodes(8000000),
-      cudd_init_cache_size(8000000),
-      cudd_init_available_memory(0),
+      cudd_init_nodes(opts.get<int>("cudd_init_nodes")),
+      cudd_init_cache_size(opts.get<int>("cudd_init_cache_size")),
+      cudd_init_available_memory(
+          static_cast<long>(opts.get<int>("cudd_max_memory")) * 1024 * 1024),
+      variable_order_type(variable_order_finder::VariableOrderType(
+          opts.get_enum("bdd_variable_order"))),
+      dynamic_reordering(opts.get<bool>("bdd_reordering")),
+      max_reordering_time(opts.get<double>("bdd_max_reordering_time")),
+      peak_memory(0),
+      batch_size(opts.get<int>("bdd_close_batch")),
+      num_flushes(0),
       task_proxy(task_proxy),
       manager(nullptr) {
   Init(task_proxy);
@@ -40,7 +51,16 @@ void SymbolicClosedList::Init(const TaskProxy &task_proxy) {
 
   bdd_index.resize(variables.size());
 
-  for (auto var : variables) {
+  /*
+    The regression task has the same variables as the root task, whose
+    causal graph places related variables close to each other.
+  */
+  TaskProxy root_task_proxy(*tasks::g_root_task);
+  variable_order_finder::VariableOrderFinder order(root_task_proxy,
+                                                   variable_order_type);
+
+  while (!order.done()) {
+    VariableProxy var = variables[order.next()];
     int var_len = std::ceil(std::log2(var.get_domain_size()));
 
     for (int j = 0; j < var_len; ++j) {
@@ -53,6 +73,11 @@ void SymbolicClosedList::Init(const TaskProxy &task_proxy) {
       new Cudd(n_bdd_vars, 0, cudd_init_nodes / n_bdd_vars,
                cudd_init_cache_size, cudd_init_available_memory));
 
+  if (cudd_init_available_memory > 0)
+    manager->SetMaxMemory(cudd_init_available_memory);
+
+  if (dynamic_reordering) manager->AutodynEnable(CUDD_REORDER_SIFT);
+
   closed = manager->bddZero();
 
   for (int i = 0; i < n_bdd_vars; ++i)
@@ -60,6 +85,9 @@ void SymbolicClosedList::Init(const TaskProxy &task_proxy) {
 
   var_value_to_bdd.resize(variables.size());
 
+  for (auto var : variables)
+    unknown_values.push_back(var.get_domain_size() - 1);
+
   for (auto var : variables) {
     for (int j = 0; j < var.get_domain_size(); ++j)
       var_value_to_bdd[var.get_id()].push_back(GenerateBDDVar(var.get_id(), j));
@@ -80,32 +108,223 @@ BDD SymbolicClosedList::GetStateBDD(const GlobalState &state) const {
   return res;
 }
 
-bool SymbolicClosedList::IsClosed(const GlobalState &state) const {
+bool SymbolicClosedList::IsPendingSubsumed(const GlobalState &state) const {
+  if (pending_ids.count(state.get_id().get_value())) return true;
+
+  for (const std::vector<int> &pending : pending_states) {
+    bool subsumed = true;
+
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+      if (pending[i] != unknown_values[i] && pending[i] != state[i]) {
+        subsumed = false;
+        break;
+      }
+    }
+
+    if (subsumed) return true;
+  }
+
+  return false;
+}
+
+bool SymbolicClosedList::IntersectsPending(const GlobalState &state) const {
+  for (const std::vector<int> &pending : pending_states) {
+    bool intersects = true;
+
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+      if (pending[i] != unknown_values[i] && state[i] != unknown_values[i] &&
+          pending[i] != state[i]) {
+        intersects = false;
+        break;
+      }
+    }
+
+    if (intersects) return true;
+  }
+
+  return false;
+}
+
+void SymbolicClosedList::AddToPending(const GlobalState &state) {
+  if (!pending_ids.insert(state.get_id().get_value()).second) return;
+
+  std::vector<int> values(unknown_values.size());
+  for (std::size_t i = 0; i < values.size(); ++i) values[i] = state[i];
+  pending_states.push_back(std::move(values));
+
+  if (static_cast<int>(pending_states.size()) >= batch_size) FlushPending();
+}
+
+void SymbolicClosedList::FlushPending() {
+  if (pending_states.empty()) return;
+
+  std::vector<BDD> layer;
+  layer.reserve(pending_states.size());
+
+  for (const std::vector<int> &pending : pending_states) {
+    BDD res = manager->bddOne();
+
+    for (int i = static_cast<int>(pending.size()) - 1; i >= 0; --i) {
+      if (pending[i] == unknown_values[i]) continue;
+
+      res = res * var_value_to_bdd[i][pending[i]];
+    }
+
+    layer.push_back(res);
+  }
+
+  while (layer.size() > 1) {
+    std::vector<BDD> next;
+    next.reserve((layer.size() + 1) / 2);
+
+    for (std::size_t i = 0; i + 1 < layer.size(); i += 2)
+      next.push_back(layer[i] + layer[i + 1]);
+
+    if (layer.size() % 2 == 1) next.push_back(layer.back());
+    layer.swap(next);
+  }
+
+  closed += layer[0];
+  pending_ids.clear();
+  pending_states.clear();
+  ++num_flushes;
+  AfterClose();
+}
+
+bool SymbolicClosedList::IsClosed(const GlobalState &state) {
+  if (IsPendingSubsumed(state)) return true;
+
   BDD state_bdd = GetStateBDD(state);
 
+  if (state_bdd * closed == state_bdd) return true;
+
+  /*
+    The state may still be covered by closed together with the pending
+    states that intersect it, which only the BDD can tell.
+  */
+  if (!IntersectsPending(state)) return false;
+
+  FlushPending();
+
   return state_bdd * closed == state_bdd;
 }
 
 bool SymbolicClosedList::IsSubsumed(const GlobalState &state) const {
+  if (IntersectsPending(state)) return true;
+
   BDD state_bdd = GetStateBDD(state);
 
   return !(state_bdd * closed).IsZero();
 }
 
 bool SymbolicClosedList::CloseIfNot(const GlobalState &state) {
-  BDD state_bdd = GetStateBDD(state);
+  if (IsClosed(state)) return false;
 
-  if (state_bdd * closed != state_bdd) {
-    closed += state_bdd;
-    return true;
-  }
+  Close(state);
 
-  return false;
+  return true;
 }
 
 void SymbolicClosedList::Close(const GlobalState &state) {
+  if (batch_size > 1) {
+    AddToPending(state);
+    return;
+  }
+
   BDD state_bdd = GetStateBDD(state);
   closed += state_bdd;
+  AfterClose();
+}
+
+void SymbolicClosedList::AfterClose() {
+  std::size_t memory = manager->ReadMemoryInUse();
+  if (memory > peak_memory) peak_memory = memory;
+
+  if (dynamic_reordering &&
+      manager->ReadReorderingTime() / 1000.0 > max_reordering_time) {
+    manager->AutodynDisable();
+    dynamic_reordering = false;
+    std::cout << "BDD reordering time limit reached; reordering disabled"
+              << std::endl;
+  }
+}
+
+std::size_t SymbolicClosedList::GetMemoryInUse() const {
+  return manager ? manager->ReadMemoryInUse() : 0;
+}
+
+void SymbolicClosedList::Release() {
+  if (!manager) return;
+
+  std::size_t memory = manager->ReadMemoryInUse();
+  if (memory > peak_memory) peak_memory = memory;
+
+  std::unordered_set<int>().swap(pending_ids);
+  std::vector<std::vector<int>>().swap(pending_states);
+  std::vector<std::vector<BDD>>().swap(var_value_to_bdd);
+  std::vector<BDD>().swap(bdd_variables);
+  closed = BDD();
+  // The manager must outlive all of its BDDs.
+  manager.reset();
+}
+
+void SymbolicClosedList::PrintStatistics(const std::string &name) const {
+  if (!manager) {
+    std::cout << name << " closed BDDs released" << std::endl;
+    std::cout << name << " CUDD peak memory: " << peak_memory / 1024 << " KB"
+              << std::endl;
+    return;
+  }
+
+  std::cout << name << " closed BDD nodes: " << closed.nodeCount()
+            << std::endl;
+  std::cout << name << " CUDD peak node count: "
+            << manager->ReadPeakNodeCount() << std::endl;
+  std::cout << name << " CUDD peak memory: " << peak_memory / 1024 << " KB"
+            << std::endl;
+  std::cout << name << " CUDD reorderings: " << manager->ReadReorderings()
+            << " (" << manager->ReadReorderingTime() / 1000.0 << "s)"
+            << std::endl;
+
+  if (batch_size > 1) {
+    std::cout << name << " closed BDD flushes: " << num_flushes << " ("
+              << pending_states.size() << " states pending)" << std::endl;
+  }
+}
+
+void add_options_to_parser(options::OptionParser &parser) {
+  parser.add_option<int>("cudd_init_nodes",
+                         "initial number of BDD nodes in the unique tables",
+                         "8000000", options::Bounds("1", "infinity"));
+  parser.add_option<int>("cudd_init_cache_size",
+                         "initial number of entries in the CUDD cache",
+                         "8000000", options::Bounds("1", "infinity"));
+  parser.add_option<int>("cudd_max_memory",
+                         "memory limit of CUDD in MB (0 means no limit)", "0",
+                         options::Bounds("0", "infinity"));
+
+  std::vector<std::string> variable_orders;
+  variable_orders.push_back("CG_GOAL_LEVEL");
+  variable_orders.push_back("CG_GOAL_RANDOM");
+  variable_orders.push_back("GOAL_CG_LEVEL");
+  variable_orders.push_back("RANDOM");
+  variable_orders.push_back("LEVEL");
+  variable_orders.push_back("REVERSE_LEVEL");
+  parser.add_enum_option("bdd_variable_order", variable_orders,
+                         "the order of the task variables in the BDDs",
+                         "CG_GOAL_LEVEL");
+  parser.add_option<bool>("bdd_reordering",
+                          "reorder BDD variables dynamically by sifting",
+                          "false");
+  parser.add_option<double>(
+      "bdd_max_reordering_time",
+      "time in seconds after which dynamic reordering is disabled",
+      "infinity", options::Bounds("0.0", "infinity"));
+  parser.add_option<int>(
+      "bdd_close_batch",
+      "number of closed states that are buffered and merged into the closed "
+      "BDD at once (1 merges every state immediately)",
+      "1", options::Bounds("1", "infinity"));
 }
 
 }  // namespace symbolic_closed
\ No newline at end of file
@@ -5,10 +5,14 @@
 #include "../options/option_parser.h"
 #include "../options/options.h"
 #include "../task_proxy.h"
+#include "../task_utils/variable_order_finder.h"
 
 #include "cuddObj.hh"
 
+#include <cstddef>
 #include <memory>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace symbolic_closed {
@@ -16,15 +20,38 @@ namespace symbolic_closed {
 class SymbolicClosedList {
   void Init(const TaskProxy &task_proxy);
 
+  // Called after closing states to update statistics and time limits.
+  void AfterClose();
+
+  void AddToPending(const GlobalState &state);
+
+  /*
+    Merge the pending states into closed with a balanced disjunction
+    tree, which keeps the intermediate BDDs small.
+  */
+  void FlushPending();
+
+  // Whether state is contained in some pending state.
+  bool IsPendingSubsumed(const GlobalState &state) const;
+
+  // Whether state and some pending state have a common completion.
+  bool IntersectsPending(const GlobalState &state) const;
+
  public:
-  SymbolicClosedList(const TaskProxy &task_proxy);
+  SymbolicClosedList(const TaskProxy &task_proxy, const options::Options &opts);
   ~SymbolicClosedList() {}
 
   BDD GenerateBDDVar(int var, int value) const;
 
   BDD GetStateBDD(const GlobalState &state) const;
 
-  bool IsClosed(const GlobalState &state) const;
+  /*
+    The checks consult both the closed BDD and the pending states, so
+    they give the same answers as with immediate closing. IsClosed
+    flushes the pending states when only their union with closed can
+    tell.
+  */
+  bool IsClosed(const GlobalState &state);
 
   bool IsSubsumed(const GlobalState &state) const;
 
@@ -32,11 +59,34 @@ class SymbolicClosedList {
 
   void Close(const GlobalState &state);
 
+  // Memory in bytes that CUDD uses, or 0 after Release.
+  std::size_t GetMemoryInUse() const;
+
+  /*
+    Free the BDDs and the CUDD manager. Afterwards, only GetMemoryInUse
+    and PrintStatistics may be called.
+  */
+  void Release();
+
+  void PrintStatistics(const std::string &name) const;
+
  private:
   int n_bdd_vars;
   long cudd_init_nodes;
   long cudd_init_cache_size;
   long cudd_init_available_memory;
+  variable_order_finder::VariableOrderType variable_order_type;
+  bool dynamic_reordering;
+  // In seconds; dynamic reordering is disabled when it is used up.
+  double max_reordering_time;
+  std::size_t peak_memory;
+  // Closed states are merged into closed in batches of this size.
+  int batch_size;
+  int num_flushes;
+  std::vector<int> unknown_values;
+  // IDs of the pending states, for exact duplicates.
+  std::unordered_set<int> pending_ids;
+  std::vector<std::vector<int>> pending_states;
   TaskProxy task_proxy;
   std::unique_ptr<Cudd> manager;
   std::vector<std::vector<int>> bdd_index;
@@ -45,6 +95,8 @@ class SymbolicClosedList {
   BDD closed;
 };
 
+extern void add_options_to_parser(options::OptionParser &parser);
+
 }  // namespace symbolic_closed
 
 #endif  // SYMBOLIC_CLOSED_H_
\ No newline at end of file
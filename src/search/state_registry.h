@@ -181,6 +181,8 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
 
   int get_num_variables() const { return num_variables; }
 
+  const int_packer::IntPacker &get_state_packer() const { return state_packer; }
+
   int get_state_value(const PackedStateBin *buffer, int var) const {
     return state_packer.get(buffer, var);
   }
@@ -615,6 +615,16 @@ public:
         return values;
     }
 
+    /*
+      Move the values out of the state, which is left without a task
+      and values. This lets callers reuse the memory of a state that is
+      no longer needed.
+    */
+    std::vector<int> release_values() {
+        task = nullptr;
+        return std::move(values);
+    }
+
     State get_successor(OperatorProxy op) const {
         if (task->get_num_axioms() > 0) {
             ABORT("State::get_successor currently does not support axioms.");
@@ -698,6 +708,15 @@ public:
         return create_state(std::move(state_values));
     }
 
+    /*
+      Like convert_ancestor_state, but convert the values of a state of
+      the task of ancestor_task_proxy in place instead of copying them.
+    */
+    void convert_ancestor_state_values(
+        std::vector<int> &values, const TaskProxy &ancestor_task_proxy) const {
+        task->convert_state_values(values, ancestor_task_proxy.task);
+    }
+
     const causal_graph::CausalGraph &get_causal_graph() const;
 };
 
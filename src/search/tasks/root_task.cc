@@ -56,6 +56,7 @@ class RootTask : public AbstractTask {
   virtual string get_fact_name(const FactPair &fact) const override;
   virtual bool are_facts_mutex(const FactPair &fact1,
                                const FactPair &fact2) const override;
+  const set<FactPair> &get_mutexes(const FactPair &fact) const;
 
   virtual int get_operator_cost(int index, bool is_axiom) const override;
   virtual string get_operator_name(int index, bool is_axiom) const override;
@@ -405,6 +406,12 @@ bool RootTask::are_facts_mutex(const FactPair &fact1,
   return bool(mutexes[fact1.var][fact1.value].count(fact2));
 }
 
+const set<FactPair> &RootTask::get_mutexes(const FactPair &fact) const {
+  assert(utils::in_bounds(fact.var, mutexes));
+  assert(utils::in_bounds(fact.value, mutexes[fact.var]));
+  return mutexes[fact.var][fact.value];
+}
+
 int RootTask::get_operator_cost(int index, bool is_axiom) const {
   return get_operator_or_axiom(index, is_axiom).cost;
 }
@@ -481,6 +488,11 @@ void read_root_task(istream &in) {
   g_root_task = make_shared<RootTask>(in);
 }
 
+const set<FactPair> &get_root_task_mutexes(const FactPair &fact) {
+  assert(g_root_task);
+  return static_cast<const RootTask &>(*g_root_task).get_mutexes(fact);
+}
+
 static shared_ptr<AbstractTask> _parse(OptionParser &parser) {
   if (parser.dry_run())
     return nullptr;
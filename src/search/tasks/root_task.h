@@ -3,10 +3,18 @@
 
 #include "../abstract_task.h"
 
+#include <set>
+
 namespace tasks {
 extern std::shared_ptr<AbstractTask> g_root_task;
 extern void read_root_task(std::istream &in);
 
+/*
+  The facts of other variables that are mutex with fact according to
+  the mutex groups of the root task, ordered by variable and value.
+*/
+extern const std::set<FactPair> &get_root_task_mutexes(const FactPair &fact);
+
 struct ExplicitEffect {
   FactPair fact;
   std::vector<FactPair> conditions;
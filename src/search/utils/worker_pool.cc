@@ -0,0 +1,78 @@
+#include "worker_pool.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace utils {
+WorkerPool::WorkerPool(int num_workers)
+    : job(nullptr),
+      num_jobs(0),
+      num_pending(0),
+      generation(0),
+      stopping(false) {
+    workers.reserve(num_workers);
+    for (int i = 0; i < num_workers; ++i) {
+        workers.emplace_back(&WorkerPool::work, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    job_ready.notify_all();
+    for (thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::work(int worker_id) {
+    uint64_t last_generation = 0;
+    unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        job_ready.wait(lock, [this, last_generation]() {
+                           return stopping || generation != last_generation;
+                       });
+        if (stopping) {
+            return;
+        }
+        last_generation = generation;
+        int job_id = worker_id + 1;
+        // Workers without a job in this round wait for the next one.
+        if (job_id >= num_jobs) {
+            continue;
+        }
+        const function<void(int)> &current_job = *job;
+        lock.unlock();
+        current_job(job_id);
+        lock.lock();
+        if (--num_pending == 0) {
+            job_done.notify_one();
+        }
+    }
+}
+
+void WorkerPool::run(int num_jobs, const function<void(int)> &job) {
+    if (num_jobs <= 0) {
+        return;
+    }
+    assert(num_jobs <= get_num_workers() + 1);
+    if (num_jobs > 1) {
+        {
+            lock_guard<std::mutex> lock(mutex);
+            this->job = &job;
+            this->num_jobs = num_jobs;
+            num_pending = num_jobs - 1;
+            ++generation;
+        }
+        job_ready.notify_all();
+    }
+    job(0);
+    if (num_jobs > 1) {
+        unique_lock<std::mutex> lock(mutex);
+        job_done.wait(lock, [this]() {return num_pending == 0;});
+    }
+}
+}
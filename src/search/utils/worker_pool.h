@@ -0,0 +1,52 @@
+#ifndef UTILS_WORKER_POOL_H
+#define UTILS_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+/*
+  A fixed set of threads that run the jobs of one call to run() at a
+  time. Starting a thread costs tens of microseconds, which is more than
+  evaluating a few states with most heuristics, so callers that split
+  every expansion into jobs should keep a pool instead of starting
+  threads for every call.
+*/
+class WorkerPool {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable job_ready;
+    std::condition_variable job_done;
+    const std::function<void(int)> *job;
+    int num_jobs;
+    int num_pending;
+    std::uint64_t generation;
+    bool stopping;
+
+    void work(int worker_id);
+public:
+    explicit WorkerPool(int num_workers);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    int get_num_workers() const {
+        return workers.size();
+    }
+
+    /*
+      Call job(i) for all i in [0, num_jobs) and return when all calls
+      have returned. Job 0 runs on the calling thread and job i > 0 on
+      worker i - 1, so jobs can use per-thread data indexed by i.
+      num_jobs must not exceed get_num_workers() + 1.
+    */
+    void run(int num_jobs, const std::function<void(int)> &job);
+};
+}
+
+#endif